@@ -1,41 +1,282 @@
+#define _GNU_SOURCE
+
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
-#include <time.h>
+#include <unistd.h>
+#include <sched.h>
 #include <assert.h>
 
 #include "u512.h"
 #include "fp.h"
 #include "mont.h"
 #include "csidh.h"
+#include "ctidh.h"
+#include "radical.h"
+#include "rng.h"
 #include "cycle.h"
+#include "perf.h"
+
+/* per-function microbenchmarks.
+ * every benchmark runs some warm-up samples first, then records samples
+ * of reps calls each; we report quartiles of the cycles per call.
+ * with -p, hardware counters are read around every sample as well and
+ * their medians per call are reported next to the cycles.
+ * usage: ./bench [-c core] [-o results.csv] [-p] [-s scale] [filter] */
+
+static uint8_t num_batches = default_num_batches;
+static uint8_t my = default_my;
+static unsigned int num_isogenies = default_num_isogenies;
+
+static int8_t const *max = default_max;
+
+static double scale = 1;
+static char const *filter = NULL;
+static FILE *csv = NULL;
+static bool perf = false;
+
+typedef struct bench {
+	char const *name;
+	unsigned long samples;
+	unsigned long reps;
+	void (*setup)(void); /* not timed, runs before every sample */
+	void (*run)(void);
+} bench;
+
+
+static int cmp_double(void const *a, void const *b) {
+	double x = *(double const *) a, y = *(double const *) b;
+	return (x > y) - (x < y);
+}
+
+static double median(double *t, unsigned long n) {
+	qsort(t, n, sizeof(*t), cmp_double);
+	return t[n / 2];
+}
+
+static void measure(bench const *b, char const *name) {
+	unsigned long samples = b->samples * scale, warmup = samples / 10 + 1;
+	double *t, *c[perf_num_counters], med_c[perf_num_counters];
+	uint64_t values[perf_num_counters];
+	ticks t0, t1;
+
+	if (filter && !strstr(name, filter))
+		return;
+	if (!samples)
+		samples = 1;
+	if (!(t = calloc(samples, sizeof(*t))))
+		exit(1);
+	for (size_t k = 0; k < perf_num_counters; ++k)
+		if (!(c[k] = calloc(samples, sizeof(*c[k]))))
+			exit(1);
+
+	for (unsigned long i = 0; i < warmup + samples; ++i) {
+		if (b->setup)
+			b->setup();
+		if (perf)
+			perf_start();
+		t0 = getticks();
+		for (unsigned long j = 0; j < b->reps; ++j)
+			b->run();
+		t1 = getticks();
+		if (perf)
+			perf_stop(values);
+		if (i >= warmup) {
+			t[i - warmup] = elapsed(t1, t0) / b->reps;
+			for (size_t k = 0; perf && k < perf_num_counters; ++k)
+				c[k][i - warmup] = (double) values[k] / b->reps;
+		}
+	}
 
-#include <inttypes.h>
+	qsort(t, samples, sizeof(*t), cmp_double);
+	double q1 = t[samples / 4], med = t[samples / 2], q3 = t[3 * samples / 4];
+	for (size_t k = 0; k < perf_num_counters; ++k)
+		med_c[k] = median(c[k], samples);
 
-static __inline__ uint64_t rdtsc(void) {
-	uint32_t hi, lo;
-	__asm__ __volatile__ ("rdtsc" : "=a"(lo), "=d"(hi));
-	return lo | (uint64_t) hi << 32;
+	printf("%-20s %12.0lf %12.0lf %12.0lf %8lu", name, q1, med, q3, samples);
+	if (perf) {
+		if (perf_available(PERF_CYCLES) && perf_available(PERF_INSTRUCTIONS))
+			printf(" %6.2lf", med_c[PERF_CYCLES] ? med_c[PERF_INSTRUCTIONS] / med_c[PERF_CYCLES] : 0);
+		else
+			printf(" %6s", "n/a");
+		for (size_t k = PERF_INSTRUCTIONS; k < perf_num_counters; ++k) {
+			if (perf_available(k))
+				printf(" %14.1lf", med_c[k]);
+			else
+				printf(" %14s", "n/a");
+		}
+	}
+	printf("\n");
+	fflush(stdout);
+
+	if (csv) {
+		fprintf(csv, "%s,%lu,%.0lf,%.0lf,%.0lf,%.0lf,%.0lf", name, samples,
+				t[0], q1, med, q3, t[samples - 1]);
+		for (size_t k = 0; perf && k < perf_num_counters; ++k) {
+			if (perf_available(k))
+				fprintf(csv, ",%.1lf", med_c[k]);
+			else
+				fprintf(csv, ",");
+		}
+		fprintf(csv, "\n");
+	}
+
+	for (size_t k = 0; k < perf_num_counters; ++k)
+		free(c[k]);
+	free(t);
 }
 
-unsigned long its = 10000;
 
-int main() {
-	clock_t t0, t1, time = 0;
-	uint64_t c0, c1, cycles = 0;
-	uint64_t allticks = 0;
-	ticks ticks1, ticks2;
+/* field arithmetic */
+
+static struct { fp x, y, v[8], w[8]; } fctx;
+
+static void setup_fp(void) { fp_random(&fctx.x); fp_random(&fctx.y); }
+static void setup_fp4(void) { for (size_t i = 0; i < 8; ++i) { fp_random(&fctx.v[i]); fp_random(&fctx.w[i]); } }
+static void run_fp_mul3(void) { fp_mul3(&fctx.x, &fctx.x, &fctx.y); }
+static void run_fp_mul4(size_t n)
+{
+	fp *x[4] = { &fctx.v[0], &fctx.v[1], &fctx.v[2], &fctx.v[3] };
+	fp const *w[4] = { &fctx.w[0], &fctx.w[1], &fctx.w[2], &fctx.w[3] };
+	fp_mul4(x, (fp const *const *) x, w, n);
+}
+static void run_fp_mul4_2(void) { run_fp_mul4(2); }
+static void run_fp_mul4_4(void) { run_fp_mul4(4); }
+static void run_fp_mul8_8(void)
+{
+	fp *x[8] = { &fctx.v[0], &fctx.v[1], &fctx.v[2], &fctx.v[3], &fctx.v[4], &fctx.v[5], &fctx.v[6], &fctx.v[7] };
+	fp const *w[8] = { &fctx.w[0], &fctx.w[1], &fctx.w[2], &fctx.w[3], &fctx.w[4], &fctx.w[5], &fctx.w[6], &fctx.w[7] };
+	fp_mul8(x, (fp const *const *) x, w, 8);
+}
+static void run_fp_sq2(void) { fp_sq2(&fctx.x, &fctx.x); }
+static void run_fp_inv(void) { fp_inv(&fctx.x); }
+static void run_fp_issquare(void) { fctx.y.x.c[0] ^= fp_issquare(&fctx.x); }
 
-	uint8_t num_batches = 3;
-	uint8_t my = 8;
 
-	int8_t max[num_primes] = {2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
-					4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 5, 5, 5, 5, 5,
-					5, 5, 6, 6, 6, 6, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 8,
-					9, 9, 9, 10, 10, 10, 10, 9, 8, 8, 8, 7, 7, 7, 7, 7, 6, 5,
-					1, 2, 2};
+/* curve arithmetic; the curve is a random public key */
+
+static struct {
+	curve E, E0;
+	proj P, Q, PQ, K, Pd;
+	proj points[8];
+	size_t n;
+	u512 k;
+	uint64_t l;
+	int8_t bound;
+	public_key pub;
+	private_key priv;
+} cctx;
+
+static void setup_points(void) {
+	cctx.E = cctx.E0;
+	elligator(&cctx.P, &cctx.Pd, &cctx.E.A);
+	elligator(&cctx.Q, &cctx.K, &cctx.E.A);
+	elligator(&cctx.PQ, &cctx.K, &cctx.E.A);
+	fp_random((fp *) &cctx.k);
+	for (size_t i = 0; i < 8; i += 2)
+		elligator(&cctx.points[i], &cctx.points[i + 1], &cctx.E.A);
+}
+static void run_xDBLADD(void) { xDBLADD(&cctx.P, &cctx.Q, &cctx.P, &cctx.Q, &cctx.PQ, &cctx.E.A24); }
+static void run_xMUL(void) { xMUL(&cctx.Q, &cctx.E, &cctx.P, &cctx.k); }
+static void run_xMUL2(void) { xMUL2(&cctx.Q, &cctx.PQ, &cctx.E, &cctx.P, &cctx.Pd, &cctx.k); }
+static void run_xMUL_ct(void) { xMUL_ct(&cctx.Q, &cctx.E, &cctx.P, &cctx.k, PBITS); }
+static void run_xISOG(void) { xISOG(&cctx.E, &cctx.P, &cctx.Pd, &cctx.K, cctx.l, 0); }
+static void run_xISOG_n(void) { xISOG_n(&cctx.E, cctx.points, cctx.n, &cctx.K, cctx.l, 0); }
+static void run_xISOG_matryoshka(void) {
+	isog_point w[2];
+	xISOG_matryoshka(&cctx.E, cctx.points, 2, &cctx.K, 3, cctx.l, 0, w);
+}
+static void run_radical_isog(void) { radical_isog(&cctx.E.A.x, cctx.l, cctx.bound, cctx.bound); }
+static void run_lastxISOG(void) { lastxISOG(&cctx.E, &cctx.K, cctx.l, 0); }
+static void run_elligator(void) { elligator(&cctx.P, &cctx.Pd, &cctx.E.A); }
+static void run_validate(void) { bool ok = validate(&cctx.pub); assert(ok); (void) ok; }
+static void run_validate_batch(void) { /* validate_lanes keys per call */
+	public_key in[validate_lanes];
+	bool ok[validate_lanes];
+	for (size_t i = 0; i < validate_lanes; ++i)
+		in[i] = cctx.pub;
+	validate_batch(in, ok, validate_lanes);
+	for (size_t i = 0; i < validate_lanes; ++i)
+		assert(ok[i]);
+}
+
 
-	unsigned int num_isogenies = 404;
+/* protocol */
+
+static void setup_private(void) { csidh_private(&cctx.priv, max); }
+static void run_csidh_private(void) { csidh_private(&cctx.priv, max); }
+static void run_action(void) {
+	action(&cctx.pub, &base, &cctx.priv, num_batches, max, num_isogenies, my);
+}
+static void run_action_vartime(void) { action_vartime(&cctx.pub, &base, &cctx.priv); }
+/* one action_step() of budget 1, across whole actions */
+static action_state astate;
+static bool astate_busy;
+static void run_action_step(void) {
+	if (!astate_busy) {
+		csidh_private(&cctx.priv, max);
+		action_init(&astate, &base, &cctx.priv, num_batches, max, num_isogenies, my);
+		astate_busy = true;
+	}
+	if (action_step(&astate, 1)) {
+		action_finish(&cctx.pub, &astate);
+		astate_busy = false;
+	}
+}
+static void setup_ctidh_private(void) { ctidh_private(&cctx.priv); }
+static void run_ctidh_private(void) { ctidh_private(&cctx.priv); }
+static void run_ctidh_action(void) { ctidh_action(&cctx.pub, &base, &cctx.priv); }
+static void run_ctidh(void) {
+	public_key out;
+	bool ok = ctidh(&out, &cctx.pub, &cctx.priv);
+	assert(ok);
+	(void) ok;
+}
+static void run_csidh(void) {
+	public_key out;
+	bool ok = csidh(&out, &cctx.pub, &cctx.priv, num_batches, max, num_isogenies, my);
+	assert(ok);
+	(void) ok;
+}
+
+
+static void pin(int core) {
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(core, &set);
+	if (sched_setaffinity(0, sizeof(set), &set))
+		fprintf(stderr, "warning: could not pin to core %d\n", core);
+}
+
+int main(int argc, char **argv) {
+	int opt, core = 0;
+	char name[32];
+
+	while ((opt = getopt(argc, argv, "c:o:ps:")) != -1) {
+		switch (opt) {
+		case 'c': core = atoi(optarg); break;
+		case 'o':
+			if (!(csv = fopen(optarg, "w"))) {
+				perror(optarg);
+				return 1;
+			}
+			break;
+		case 'p': perf = true; break;
+		case 's': scale = atof(optarg); break;
+		default:
+			fprintf(stderr, "usage: %s [-c core] [-o results.csv] [-p] [-s scale] [filter]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (optind < argc)
+		filter = argv[optind];
+
+	pin(core);
+
+	if (perf && !perf_open()) {
+		fprintf(stderr, "warning: no hardware counters available, reporting cycles only\n");
+		perf = false;
+	}
 
 	// calculate inverses for "elligatoring"
 	// create inverse of u^2 - 1 : from 2 - 11
@@ -46,34 +287,99 @@ int main() {
 		fp_inv(&invs_[i - 2]);
 	}
 
-	private_key priv;
-	public_key pub = base;
-
-	for (unsigned long i = 0; i < its; ++i) {
-
-		csidh_private(&priv, max);
-
-		t0 = clock();
-		c0 = rdtsc();
-		ticks1 = getticks();
-		/**************************************/
-		//assert(validate(&pub));
-		action(&pub, &pub, &priv, num_batches, max, num_isogenies, my);
-		/**************************************/
-		ticks2 = getticks();
-		allticks = allticks + elapsed(ticks2, ticks1);
-		c1 = rdtsc();
-		t1 = clock();
-		cycles += c1 - c0;
-		time += t1 - t0;
-		printf("%" PRIu64 "\n", (uint64_t) (c1 - c0));
-		printf("%.3lf\n", 1000. * (t1 - t0) / CLOCKS_PER_SEC);
+	csidh_private(&cctx.priv, max);
+	action(&cctx.pub, &base, &cctx.priv, num_batches, max, num_isogenies, my);
+	curve_set(&cctx.E0, &(proj) { cctx.pub.A, fp_1 });
+
+	if (csv) {
+		fprintf(csv, "name,samples,min,q1,median,q3,max");
+		for (size_t k = 0; perf && k < perf_num_counters; ++k)
+			fprintf(csv, ",%s", perf_names[k]);
+		fprintf(csv, "\n");
+	}
+	printf("p of %d bits, %d primes, %d limbs\n\n", PBITS, num_primes, LIMBS);
+	printf("%-20s %12s %12s %12s %8s", "cycles", "q1", "median", "q3", "samples");
+	if (perf) {
+		printf(" %6s", "ipc");
+		for (size_t k = PERF_INSTRUCTIONS; k < perf_num_counters; ++k)
+			printf(" %14s", perf_names[k]);
 	}
+	printf("\n");
 
-	printf("iterations: %lu\n", its);
-	printf("clock cycles: %" PRIu64 " (rdtsc)\n", (uint64_t) cycles / its);
-	printf("clock cycles: %" PRIu64 " (getticks)\n", (uint64_t) allticks / its);
+	bench const fp_benches[] = {
+		{ "fp_mul3", 10000, 100, setup_fp, run_fp_mul3 },
+		{ "fp_sq2", 10000, 100, setup_fp, run_fp_sq2 },
+		{ "fp_mul4_2", 10000, 100, setup_fp4, run_fp_mul4_2 },
+		{ "fp_mul4_4", 10000, 100, setup_fp4, run_fp_mul4_4 },
+		{ "fp_mul8_8", 10000, 100, setup_fp4, run_fp_mul8_8 },
+		{ "fp_inv", 1000, 1, setup_fp, run_fp_inv },
+		{ "fp_issquare", 1000, 1, setup_fp, run_fp_issquare },
+	};
+	for (size_t i = 0; i < sizeof(fp_benches) / sizeof(*fp_benches); ++i)
+		measure(&fp_benches[i], fp_benches[i].name);
 
-	printf("wall-clock time: %.3lf ms\n", 1000. * time / CLOCKS_PER_SEC / its);
-}
+	bench const curve_benches[] = {
+		{ "xDBLADD", 10000, 100, setup_points, run_xDBLADD },
+		{ "xMUL", 200, 1, setup_points, run_xMUL },
+		{ "xMUL2", 200, 1, setup_points, run_xMUL2 },
+		{ "xMUL_ct", 200, 1, setup_points, run_xMUL_ct },
+		{ "elligator", 1000, 1, setup_points, run_elligator },
+		{ "validate", 100, 1, NULL, run_validate },
+		{ "validate_batch_4", 100, 1, NULL, run_validate_batch },
+	};
+	for (size_t i = 0; i < sizeof(curve_benches) / sizeof(*curve_benches); ++i)
+		measure(&curve_benches[i], curve_benches[i].name);
+
+	/* kernel points are random, the arithmetic does not depend on them */
+	bench const isog = { NULL, 100, 1, setup_points, run_xISOG };
+	bench const lastisog = { NULL, 100, 1, setup_points, run_lastxISOG };
+	for (size_t i = 0; i < num_primes; ++i) {
+		cctx.l = primes[i];
+		snprintf(name, sizeof(name), "xISOG_%u", primes[i]);
+		measure(&isog, name);
+		snprintf(name, sizeof(name), "lastxISOG_%u", primes[i]);
+		measure(&lastisog, name);
+	}
 
+	/* the cost per additional point pushed through the largest isogeny */
+	bench const isog_n = { NULL, 100, 1, setup_points, run_xISOG_n };
+	cctx.l = primes[0];
+	for (cctx.n = 1; cctx.n <= 8; cctx.n *= 2) {
+		snprintf(name, sizeof(name), "xISOG_n%zu_%u", cctx.n, primes[0]);
+		measure(&isog_n, name);
+	}
+
+	/* independent of the secret degree, costs as much as the largest one */
+	bench const matryoshka = { NULL, 100, 1, setup_points, run_xISOG_matryoshka };
+	snprintf(name, sizeof(name), "xISOG_matryoshka_%u", primes[0]);
+	measure(&matryoshka, name);
+
+	/* a whole chain of default_max steps, instead of that many xISOG */
+	bench const radical = { NULL, 100, 1, setup_points, run_radical_isog };
+	for (size_t i = 0; i < num_primes; ++i) {
+		if (!radical_supported(primes[i]))
+			continue;
+		cctx.l = primes[i];
+		cctx.bound = max[i];
+		snprintf(name, sizeof(name), "radical_isog_%u", primes[i]);
+		measure(&radical, name);
+	}
+
+	bench const protocol_benches[] = {
+		{ "csidh_private", 1000, 1, NULL, run_csidh_private },
+		{ "action", 100, 1, setup_private, run_action },
+		{ "action_step_1", 10000, 1, NULL, run_action_step },
+		{ "action_vartime", 100, 1, setup_private, run_action_vartime },
+		{ "csidh", 100, 1, setup_private, run_csidh },
+		{ "ctidh_private", 1000, 1, NULL, run_ctidh_private },
+		{ "ctidh_action", 100, 1, setup_ctidh_private, run_ctidh_action },
+		{ "ctidh", 100, 1, setup_ctidh_private, run_ctidh },
+	};
+	for (size_t i = 0; i < sizeof(protocol_benches) / sizeof(*protocol_benches); ++i)
+		measure(&protocol_benches[i], protocol_benches[i].name);
+
+	if (csv)
+		fclose(csv);
+	if (perf)
+		perf_close();
+}
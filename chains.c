@@ -0,0 +1,349 @@
+/* generated by python3 genchains.py 1024, do not edit */
+
+#include "chains.h"
+
+static const uint8_t chain_3[][3] = {{1, 0, 0}, {0, 1, 0}};
+static const uint8_t chain_5[][3] = {{1, 0, 0}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_7[][3] = {{1, 0, 0}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_11[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_13[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_17[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_19[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_23[][3] = {{1, 0, 0}, {1, 1, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_29[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_31[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_37[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_41[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_43[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_47[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 2}};
+static const uint8_t chain_53[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_59[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {0, 2, 0}, {2, 0, 0}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_61[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_67[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_71[][3] = {{1, 0, 0}, {2, 1, 1}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_73[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_79[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_83[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_89[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_97[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_101[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_103[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_107[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {0, 2, 0}, {2, 0, 0}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_109[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_113[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_127[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_131[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_137[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_139[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_149[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_151[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_157[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_163[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_167[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_173[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_179[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 2}};
+static const uint8_t chain_181[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_191[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 3}};
+static const uint8_t chain_193[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_197[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_199[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_211[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {0, 2, 0}, {2, 0, 0}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_223[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_227[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {0, 2, 0}, {2, 0, 0}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_229[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}, {2, 0, 0}, {1, 2, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_233[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}, {1, 0, 1}, {0, 1, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 1}};
+static const uint8_t chain_239[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {1, 3, 1}, {0, 1, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 2}};
+static const uint8_t chain_241[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_251[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {0, 2, 0}, {2, 0, 0}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_257[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_263[][3] = {{1, 0, 0}, {2, 1, 1}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_269[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_271[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 2}};
+static const uint8_t chain_277[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_281[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_283[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 2}};
+static const uint8_t chain_293[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_307[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {2, 3, 2}, {0, 2, 0}, {2, 0, 0}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_311[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_313[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_317[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {0, 2, 0}, {1, 0, 1}, {0, 1, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 1}};
+static const uint8_t chain_331[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_337[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_347[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 2}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_349[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {0, 2, 0}, {1, 0, 1}, {0, 1, 0}, {0, 0, 0}, {0, 0, 1}};
+static const uint8_t chain_353[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_359[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {1, 1, 0}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_367[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_373[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {0, 2, 0}, {1, 0, 1}, {0, 1, 0}, {0, 0, 0}, {0, 0, 1}};
+static const uint8_t chain_379[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 3}};
+static const uint8_t chain_383[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 3}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_389[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_397[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_401[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_409[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_419[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {0, 2, 0}, {2, 0, 0}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_421[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {0, 2, 0}, {1, 0, 1}, {0, 1, 0}, {0, 0, 0}, {0, 0, 1}};
+static const uint8_t chain_431[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {1, 3, 1}, {0, 1, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 2}};
+static const uint8_t chain_433[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_439[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_443[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {0, 2, 0}, {2, 0, 0}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_449[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_457[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}, {1, 0, 1}, {0, 1, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 1}};
+static const uint8_t chain_461[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {1, 3, 1}, {3, 1, 1}, {1, 3, 1}, {1, 1, 2}, {0, 1, 0}};
+static const uint8_t chain_463[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {1, 3, 1}, {0, 1, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 2}};
+static const uint8_t chain_467[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {3, 3, 3}, {1, 3, 1}, {0, 1, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 2}};
+static const uint8_t chain_479[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {0, 2, 0}, {2, 0, 0}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_487[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_491[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {0, 2, 0}, {2, 0, 0}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_499[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {0, 2, 0}, {2, 0, 0}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_503[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_509[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {0, 2, 0}, {1, 0, 1}, {0, 1, 0}, {0, 0, 0}, {0, 0, 1}};
+static const uint8_t chain_521[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_523[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_541[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {0, 2, 0}, {2, 0, 2}, {1, 2, 1}, {0, 1, 0}, {0, 0, 0}, {0, 0, 1}};
+static const uint8_t chain_547[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_557[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 2}, {0, 1, 0}, {0, 0, 0}, {0, 0, 1}};
+static const uint8_t chain_563[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 2}};
+static const uint8_t chain_569[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}, {1, 0, 0}, {1, 1, 2}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_571[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 2}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_577[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_587[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {0, 2, 0}, {2, 0, 0}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_593[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_599[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_601[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_607[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {4, 3, 3}, {3, 4, 3}, {2, 3, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_613[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}, {1, 0, 0}, {1, 1, 2}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_617[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_619[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 0}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_631[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_641[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_643[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_647[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_653[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_659[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {0, 2, 0}, {2, 0, 2}, {2, 2, 2}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_661[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_673[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_677[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {0, 2, 0}, {2, 0, 0}, {2, 2, 2}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_683[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_691[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 2}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_701[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {2, 1, 3}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_709[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {0, 2, 0}, {2, 0, 0}, {2, 2, 2}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_719[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 3}};
+static const uint8_t chain_727[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {2, 1, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_733[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {2, 1, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_739[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 2}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_743[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {2, 1, 3}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_751[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 3}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_757[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {3, 3, 3}, {1, 3, 1}, {0, 1, 0}, {1, 0, 0}, {1, 1, 1}, {0, 1, 0}, {0, 0, 2}};
+static const uint8_t chain_761[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {2, 1, 3}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_769[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_773[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_787[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {0, 2, 0}, {2, 0, 0}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_797[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_809[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}, {2, 0, 1}, {1, 2, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_811[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {1, 3, 1}, {0, 1, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 2}};
+static const uint8_t chain_821[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_823[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_827[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {0, 2, 0}, {2, 0, 0}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_829[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_839[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_853[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {0, 2, 0}, {1, 0, 1}, {0, 1, 0}, {0, 0, 0}, {0, 0, 1}};
+static const uint8_t chain_857[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {1, 3, 1}, {3, 1, 1}, {1, 3, 1}, {1, 1, 2}, {0, 1, 0}};
+static const uint8_t chain_859[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {1, 3, 1}, {0, 1, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 2}};
+static const uint8_t chain_863[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 2}, {2, 2, 2}, {0, 2, 0}, {2, 0, 0}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_877[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_881[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_883[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {3, 3, 3}, {3, 3, 3}, {2, 3, 2}, {0, 2, 0}, {2, 0, 0}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_887[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_907[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {0, 3, 0}, {3, 0, 0}, {0, 3, 0}, {0, 0, 2}, {0, 0, 1}};
+static const uint8_t chain_911[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {1, 3, 1}, {0, 1, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 2}};
+static const uint8_t chain_919[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 2}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_929[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {4, 3, 3}, {3, 4, 3}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_937[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {3, 1, 1}, {2, 3, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_941[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 0}, {1, 1, 2}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_947[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {1, 3, 1}, {0, 1, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 2}};
+static const uint8_t chain_953[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_967[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_971[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {0, 2, 0}, {2, 0, 0}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_977[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_983[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {1, 2, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {0, 1, 0}};
+static const uint8_t chain_991[][3] = {{1, 0, 0}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_997[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {3, 2, 2}, {2, 3, 2}, {0, 2, 0}, {2, 0, 0}, {2, 2, 2}, {0, 2, 0}, {0, 0, 1}};
+static const uint8_t chain_1009[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {3, 3, 3}, {2, 3, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_1013[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {3, 2, 2}, {2, 3, 2}, {0, 2, 0}, {1, 0, 1}, {0, 1, 0}, {0, 0, 0}, {0, 0, 1}};
+static const uint8_t chain_1019[][3] = {{1, 0, 0}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}, {1, 0, 1}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {1, 2, 1}, {0, 1, 0}};
+static const uint8_t chain_1021[][3] = {{1, 0, 0}, {1, 1, 1}, {2, 1, 1}, {2, 2, 2}, {2, 2, 2}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {2, 2, 2}, {1, 2, 1}, {2, 1, 1}, {1, 2, 1}, {0, 1, 0}};
+
+const addchain addchains[addchain_bound / 2] = {
+    [1] = { 2, 0, chain_3 },
+    [2] = { 3, 0, chain_5 },
+    [3] = { 4, 0, chain_7 },
+    [5] = { 5, 0, chain_11 },
+    [6] = { 5, 0, chain_13 },
+    [8] = { 5, 0, chain_17 },
+    [9] = { 6, 0, chain_19 },
+    [11] = { 6, 0, chain_23 },
+    [14] = { 7, 0, chain_29 },
+    [15] = { 7, 0, chain_31 },
+    [18] = { 7, 0, chain_37 },
+    [20] = { 7, 0, chain_41 },
+    [21] = { 7, 0, chain_43 },
+    [23] = { 8, 0, chain_47 },
+    [26] = { 8, 0, chain_53 },
+    [29] = { 8, 0, chain_59 },
+    [30] = { 8, 0, chain_61 },
+    [33] = { 8, 0, chain_67 },
+    [35] = { 9, 0, chain_71 },
+    [36] = { 8, 0, chain_73 },
+    [39] = { 9, 0, chain_79 },
+    [41] = { 8, 0, chain_83 },
+    [44] = { 9, 0, chain_89 },
+    [48] = { 8, 0, chain_97 },
+    [50] = { 9, 0, chain_101 },
+    [51] = { 9, 0, chain_103 },
+    [53] = { 9, 0, chain_107 },
+    [54] = { 9, 0, chain_109 },
+    [56] = { 9, 0, chain_113 },
+    [63] = { 10, 0, chain_127 },
+    [65] = { 9, 0, chain_131 },
+    [68] = { 9, 0, chain_137 },
+    [69] = { 10, 0, chain_139 },
+    [74] = { 9, 0, chain_149 },
+    [75] = { 10, 0, chain_151 },
+    [78] = { 10, 0, chain_157 },
+    [81] = { 9, 0, chain_163 },
+    [83] = { 10, 0, chain_167 },
+    [86] = { 10, 0, chain_173 },
+    [89] = { 10, 0, chain_179 },
+    [90] = { 10, 0, chain_181 },
+    [95] = { 11, 0, chain_191 },
+    [96] = { 9, 0, chain_193 },
+    [98] = { 10, 0, chain_197 },
+    [99] = { 10, 0, chain_199 },
+    [105] = { 10, 0, chain_211 },
+    [111] = { 11, 0, chain_223 },
+    [113] = { 10, 0, chain_227 },
+    [114] = { 10, 0, chain_229 },
+    [116] = { 10, 0, chain_233 },
+    [119] = { 11, 0, chain_239 },
+    [120] = { 10, 0, chain_241 },
+    [125] = { 11, 0, chain_251 },
+    [128] = { 9, 0, chain_257 },
+    [131] = { 11, 0, chain_263 },
+    [134] = { 11, 0, chain_269 },
+    [135] = { 11, 0, chain_271 },
+    [138] = { 11, 0, chain_277 },
+    [140] = { 10, 0, chain_281 },
+    [141] = { 11, 0, chain_283 },
+    [146] = { 10, 0, chain_293 },
+    [153] = { 11, 0, chain_307 },
+    [155] = { 11, 0, chain_311 },
+    [156] = { 11, 0, chain_313 },
+    [158] = { 11, 0, chain_317 },
+    [165] = { 11, 0, chain_331 },
+    [168] = { 11, 0, chain_337 },
+    [173] = { 11, 0, chain_347 },
+    [174] = { 11, 0, chain_349 },
+    [176] = { 11, 0, chain_353 },
+    [179] = { 11, 0, chain_359 },
+    [183] = { 11, 0, chain_367 },
+    [186] = { 11, 0, chain_373 },
+    [189] = { 12, 0, chain_379 },
+    [191] = { 12, 0, chain_383 },
+    [194] = { 11, 0, chain_389 },
+    [198] = { 11, 0, chain_397 },
+    [200] = { 11, 0, chain_401 },
+    [204] = { 11, 0, chain_409 },
+    [209] = { 11, 0, chain_419 },
+    [210] = { 11, 0, chain_421 },
+    [215] = { 12, 0, chain_431 },
+    [216] = { 11, 0, chain_433 },
+    [219] = { 12, 0, chain_439 },
+    [221] = { 12, 0, chain_443 },
+    [224] = { 11, 0, chain_449 },
+    [228] = { 11, 0, chain_457 },
+    [230] = { 12, 0, chain_461 },
+    [231] = { 12, 0, chain_463 },
+    [233] = { 12, 0, chain_467 },
+    [239] = { 12, 0, chain_479 },
+    [243] = { 12, 0, chain_487 },
+    [245] = { 12, 0, chain_491 },
+    [249] = { 12, 0, chain_499 },
+    [251] = { 12, 0, chain_503 },
+    [254] = { 12, 0, chain_509 },
+    [260] = { 11, 0, chain_521 },
+    [261] = { 12, 0, chain_523 },
+    [270] = { 12, 0, chain_541 },
+    [273] = { 12, 0, chain_547 },
+    [278] = { 12, 0, chain_557 },
+    [281] = { 12, 0, chain_563 },
+    [284] = { 12, 0, chain_569 },
+    [285] = { 12, 0, chain_571 },
+    [288] = { 11, 0, chain_577 },
+    [293] = { 12, 0, chain_587 },
+    [296] = { 12, 0, chain_593 },
+    [299] = { 12, 0, chain_599 },
+    [300] = { 12, 0, chain_601 },
+    [303] = { 13, 0, chain_607 },
+    [306] = { 12, 0, chain_613 },
+    [308] = { 12, 0, chain_617 },
+    [309] = { 12, 0, chain_619 },
+    [315] = { 12, 0, chain_631 },
+    [320] = { 11, 0, chain_641 },
+    [321] = { 11, 0, chain_643 },
+    [323] = { 12, 0, chain_647 },
+    [326] = { 12, 0, chain_653 },
+    [329] = { 12, 0, chain_659 },
+    [330] = { 12, 0, chain_661 },
+    [336] = { 12, 0, chain_673 },
+    [338] = { 12, 0, chain_677 },
+    [341] = { 12, 0, chain_683 },
+    [345] = { 12, 0, chain_691 },
+    [350] = { 13, 0, chain_701 },
+    [354] = { 12, 0, chain_709 },
+    [359] = { 13, 0, chain_719 },
+    [363] = { 13, 0, chain_727 },
+    [366] = { 13, 0, chain_733 },
+    [369] = { 12, 0, chain_739 },
+    [371] = { 13, 0, chain_743 },
+    [375] = { 13, 0, chain_751 },
+    [378] = { 13, 0, chain_757 },
+    [380] = { 13, 0, chain_761 },
+    [384] = { 11, 0, chain_769 },
+    [386] = { 12, 0, chain_773 },
+    [393] = { 12, 0, chain_787 },
+    [398] = { 13, 0, chain_797 },
+    [404] = { 12, 0, chain_809 },
+    [405] = { 13, 0, chain_811 },
+    [410] = { 13, 0, chain_821 },
+    [411] = { 13, 0, chain_823 },
+    [413] = { 13, 0, chain_827 },
+    [414] = { 13, 0, chain_829 },
+    [419] = { 12, 0, chain_839 },
+    [426] = { 13, 0, chain_853 },
+    [428] = { 13, 0, chain_857 },
+    [429] = { 13, 0, chain_859 },
+    [431] = { 13, 0, chain_863 },
+    [438] = { 13, 0, chain_877 },
+    [440] = { 13, 0, chain_881 },
+    [441] = { 13, 0, chain_883 },
+    [443] = { 13, 0, chain_887 },
+    [453] = { 13, 0, chain_907 },
+    [455] = { 13, 0, chain_911 },
+    [459] = { 13, 0, chain_919 },
+    [464] = { 13, 0, chain_929 },
+    [468] = { 13, 0, chain_937 },
+    [470] = { 13, 0, chain_941 },
+    [473] = { 13, 0, chain_947 },
+    [476] = { 13, 0, chain_953 },
+    [483] = { 13, 0, chain_967 },
+    [485] = { 13, 0, chain_971 },
+    [488] = { 13, 0, chain_977 },
+    [491] = { 13, 0, chain_983 },
+    [495] = { 13, 0, chain_991 },
+    [498] = { 13, 0, chain_997 },
+    [504] = { 13, 0, chain_1009 },
+    [506] = { 13, 0, chain_1013 },
+    [509] = { 13, 0, chain_1019 },
+    [510] = { 13, 0, chain_1021 },
+};
@@ -0,0 +1,22 @@
+/* generated by python3 genchains.py 1024, do not edit */
+
+#ifndef CHAINS_H
+#define CHAINS_H
+
+#include <stdint.h>
+
+/* shortest addition chains for the odd primes below addchain_bound;
+ * step (d, a, b) computes r[d] = r[a] * r[b], the input is r[0] */
+#define addchain_bound 1024
+#define addchain_regs 5
+
+typedef struct addchain {
+    uint8_t len;
+    uint8_t result;
+    uint8_t const (*steps)[3];
+} addchain;
+
+/* indexed by l / 2, len is 0 unless l is an odd prime */
+extern const addchain addchains[addchain_bound / 2];
+
+#endif
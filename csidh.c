@@ -1,48 +1,150 @@
 #include <string.h>
+#include <limits.h>
 #include <assert.h>
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "csidh.h"
 #include "rng.h"
+#ifdef RADICAL
+#include "radical.h"
+#endif
 
-const unsigned primes[num_primes] = {    359, 353, 349, 347, 337, 331, 317, 313, 311,
-307, 293, 283, 281, 277, 271, 269, 263, 257, 251, 241, 239, 233, 229,
-227, 223, 211, 199, 197, 193, 191, 181, 179, 173, 167, 163, 157, 151,
-149, 139, 137, 131, 127, 113, 109, 107, 103, 101, 97, 89, 83, 79, 73,
-71, 67, 61, 59, 53, 47, 43, 41, 37, 31, 29, 23, 19, 17, 13, 11, 7, 5, 3,
-587, 373, 367 };
-
-const u512 four_sqrt_p = { { 0x85e2579c786882cf, 0x4e3433657e18da95,
-		0x850ae5507965a0b3, 0xa15bc4e676475964, } };
+fp invs_[9];
 
 const public_key base = { 0 }; /* A = 0 */
 
-/* get priv[pos] in constant time  */
-int32_t lookup(size_t pos, int8_t const *priv)
+/* get priv[pos] in constant time; the portable versions are always there,
+ * as the reference for the vector ones below */
+int32_t lookup_scalar(size_t pos, int8_t const *priv)
 {
 	int b;
 	int8_t r = priv[0];
 	for(size_t i=1;i<num_primes;i++)
 	{
 		b = isequal(i, pos);
-		//ISEQUAL(i, pos, b);
-		//b = (uint8_t)(1-((-(i ^ pos)) >> 31));
 		cmov(&r, &priv[i], b);
-		//CMOV(&r, &priv[i], b);
 	}
 	return r;
 }
 
+/* set priv[pos] = v in constant time */
+void update_scalar(size_t pos, int8_t *priv, int8_t v)
+{
+	for(size_t i=0;i<num_primes;i++)
+		cmov(&priv[i], &v, isequal(i, pos));
+}
+
+/* the vector versions compare all indices against pos at once and blend;
+ * the last load is moved back so that it ends at priv[num_primes - 1],
+ * entries covered twice are simply or-ed in twice. that needs at least
+ * one vector of primes, smaller parameter sets use the scalar versions. */
+#if defined(__AVX2__) && num_primes >= 32
+
+static const int8_t iota[32] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+	16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31 };
+
+int32_t lookup(size_t pos, int8_t const *priv)
+{
+	__m256i p = _mm256_set1_epi8((char) pos);
+	__m256i r = _mm256_setzero_si256();
+	__m256i idx = _mm256_loadu_si256((__m256i const *) iota);
+	for (size_t i = 0; i < num_primes; i += 32) {
+		size_t j = i + 32 <= num_primes ? i : num_primes - 32;
+		__m256i m = _mm256_cmpeq_epi8(_mm256_add_epi8(idx, _mm256_set1_epi8((char) j)), p);
+		r = _mm256_or_si256(r, _mm256_and_si256(m, _mm256_loadu_si256((__m256i const *) &priv[j])));
+	}
+	__m128i t = _mm_or_si128(_mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1));
+	t = _mm_or_si128(t, _mm_srli_si128(t, 8));
+	t = _mm_or_si128(t, _mm_srli_si128(t, 4));
+	t = _mm_or_si128(t, _mm_srli_si128(t, 2));
+	t = _mm_or_si128(t, _mm_srli_si128(t, 1));
+	return (int8_t) _mm_cvtsi128_si32(t);
+}
+
+/* set priv[pos] = v in constant time */
+void update(size_t pos, int8_t *priv, int8_t v)
+{
+	__m256i p = _mm256_set1_epi8((char) pos);
+	__m256i w = _mm256_set1_epi8(v);
+	__m256i idx = _mm256_loadu_si256((__m256i const *) iota);
+	for (size_t i = 0; i < num_primes; i += 32) {
+		size_t j = i + 32 <= num_primes ? i : num_primes - 32;
+		__m256i m = _mm256_cmpeq_epi8(_mm256_add_epi8(idx, _mm256_set1_epi8((char) j)), p);
+		__m256i x = _mm256_loadu_si256((__m256i const *) &priv[j]);
+		_mm256_storeu_si256((__m256i *) &priv[j], _mm256_blendv_epi8(x, w, m));
+	}
+}
+
+#elif defined(__SSE2__) && num_primes >= 16
+
+static const int8_t iota[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+int32_t lookup(size_t pos, int8_t const *priv)
+{
+	__m128i p = _mm_set1_epi8((char) pos);
+	__m128i r = _mm_setzero_si128();
+	__m128i idx = _mm_loadu_si128((__m128i const *) iota);
+	for (size_t i = 0; i < num_primes; i += 16) {
+		size_t j = i + 16 <= num_primes ? i : num_primes - 16;
+		__m128i m = _mm_cmpeq_epi8(_mm_add_epi8(idx, _mm_set1_epi8((char) j)), p);
+		r = _mm_or_si128(r, _mm_and_si128(m, _mm_loadu_si128((__m128i const *) &priv[j])));
+	}
+	r = _mm_or_si128(r, _mm_srli_si128(r, 8));
+	r = _mm_or_si128(r, _mm_srli_si128(r, 4));
+	r = _mm_or_si128(r, _mm_srli_si128(r, 2));
+	r = _mm_or_si128(r, _mm_srli_si128(r, 1));
+	return (int8_t) _mm_cvtsi128_si32(r);
+}
+
+/* set priv[pos] = v in constant time */
+void update(size_t pos, int8_t *priv, int8_t v)
+{
+	__m128i p = _mm_set1_epi8((char) pos);
+	__m128i w = _mm_set1_epi8(v);
+	__m128i idx = _mm_loadu_si128((__m128i const *) iota);
+	for (size_t i = 0; i < num_primes; i += 16) {
+		size_t j = i + 16 <= num_primes ? i : num_primes - 16;
+		__m128i m = _mm_cmpeq_epi8(_mm_add_epi8(idx, _mm_set1_epi8((char) j)), p);
+		__m128i x = _mm_loadu_si128((__m128i const *) &priv[j]);
+		x = _mm_or_si128(_mm_andnot_si128(m, x), _mm_and_si128(m, w));
+		_mm_storeu_si128((__m128i *) &priv[j], x);
+	}
+}
+
+#else
+
+int32_t lookup(size_t pos, int8_t const *priv)
+{
+	return lookup_scalar(pos, priv);
+}
+
+void update(size_t pos, int8_t *priv, int8_t v)
+{
+	update_scalar(pos, priv, v);
+}
+
+#endif
+
 /* check if a and b are equal in constant time  */
 uint32_t isequal(uint32_t a, uint32_t b)
 {
-	//size_t i;
-	uint32_t r = 0;
-	unsigned char *ta = (unsigned char *)&a;
-	unsigned char *tb = (unsigned char *)&b;
-	r = (ta[0] ^ tb[0]) | (ta[1] ^ tb[1]) | (ta[2] ^ tb[2]) |  (ta[3] ^ tb[3]);
-	r = (-r);
-	r = r >> 31;
-	return (int)(1-r);
+	uint32_t r = a ^ b;
+	r = (r | -r) >> 31; /* 1 iff some bit of a ^ b is set */
+	return 1 ^ r;
+}
+
+
+/* clears secrets; the volatile stores are not optimized away */
+void zeroize(void *x, size_t l)
+{
+	volatile unsigned char *p = x;
+	while (l--)
+		*p++ = 0;
 }
 
 
@@ -59,7 +161,7 @@ void cmov(int8_t *r, const int8_t *a, uint32_t b)
 void csidh_private(private_key *priv, const int8_t *max_exponent) {
 	memset(&priv->e, 0, sizeof(priv->e));
 	for (size_t i = 0; i < num_primes;) {
-		int8_t buf[64];
+		int8_t buf[num_primes]; /* lookup() reads num_primes entries */
 		randombytes(buf, sizeof(buf));
 		for (size_t j = 0; j < sizeof(buf); ++j) {
 			if (buf[j] <= max_exponent[i] && buf[j] >= -max_exponent[i]) {
@@ -71,72 +173,188 @@ void csidh_private(private_key *priv, const int8_t *max_exponent) {
 	}
 }
 
-/* compute [(p+1)/l] P for all l in our list of primes. */
-/* divide and conquer is much faster than doing it naively,
- * but uses more memory. */
-static void cofactor_multiples(proj *P, const proj *A, size_t lower,
-		size_t upper) {
-	assert(lower < upper);
+/* A >= p is not a valid encoding, A = +-2 gives a singular curve */
+static bool plausible(public_key const *in) {
+	u512 tmp;
+	fp two, minus_two;
 
-	if (upper - lower == 1)
-		return;
+	if (!u512_sub3(&tmp, &in->A.x, &fp_p)) /* returns borrow */
+		return false;
 
-	size_t mid = lower + (upper - lower + 1) / 2;
+	fp_add3(&two, &fp_1, &fp_1);
+	fp_sub3(&minus_two, &fp_0, &two);
+	return memcmp(&in->A, &two, sizeof(fp)) && memcmp(&in->A, &minus_two, sizeof(fp));
+}
 
-	u512 cl = u512_1, cu = u512_1;
-	for (size_t i = lower; i < mid; ++i)
-		u512_mul3_64(&cu, &cu, primes[i]);
-	for (size_t i = mid; i < upper; ++i)
-		u512_mul3_64(&cl, &cl, primes[i]);
+/* [(p+1)/l] P for l = primes[lower] at a leaf of the walk */
+static void validate_leaf(validate_state *V, proj *P, size_t lower) {
+	bool nonzero[validate_lanes];
+	u512 tmp;
 
-	xMUL(&P[mid], A, &P[lower], &cu);
-	xMUL(&P[lower], A, &P[lower], &cl);
+	for (size_t j = 0; j < V->n; ++j)
+		nonzero[j] = memcmp(&P[j].z, &fp_0, sizeof(fp));
 
-	cofactor_multiples(P, A, lower, mid);
-	cofactor_multiples(P, A, mid, upper);
-}
+	u512_set(&tmp, primes[lower]);
+	xMUL_n_with(P, V->A, P, &tmp, V->n, false, V->ladder);
 
-/* never accepts invalid keys. */
-bool validate(public_key const *in) {
-	const proj A = { in->A, fp_1 };
+	for (size_t j = 0; j < V->n; ++j) {
 
-	do {
+		/* we only gain information if [(p+1)/l] P is non-zero */
+		if (V->state[j] || !nonzero[j])
+			continue;
 
-		proj P[num_primes];
-		fp_random(&P->x);
-		P->z = fp_1;
+		if (memcmp(&P[j].z, &fp_0, sizeof(fp))) {
+			/* P does not have order dividing p+1. */
+			V->state[j] = -1;
+			--V->undecided;
+			continue;
+		}
 
-		/* maximal 2-power in p+1 */
-		xDBL(P, &A, P);
-		xDBL(P, &A, P);
+		u512_mul3_64(&V->order[j], &V->order[j], primes[lower]);
 
-		cofactor_multiples(P, &A, 0, num_primes);
+		if (u512_sub3(&tmp, &four_sqrt_p, &V->order[j])) { /* returns borrow */
+			/* order > 4 sqrt(p), hence definitely supersingular */
+			V->state[j] = 1;
+			--V->undecided;
+		}
+	}
+}
 
-		u512 order = u512_1;
+/* fresh points for the lanes that are still undecided */
+static void validate_round(validate_state *V) {
+	for (size_t j = 0; j < V->n; ++j) {
+		fp_random(&V->P[j].x);
+		V->P[j].z = fp_1;
+		V->order[j] = u512_1;
+		V->state[j] = 0;
+	}
+	V->undecided = V->n;
+	V->node[0].lower = 0;
+	V->node[0].upper = num_primes;
+	V->node[0].side = 0;
+	V->top = 1;
+}
 
-		for (size_t i = num_primes - 1; i < num_primes; --i) {
+void validate_init(validate_state *V, public_key const *in, size_t n) {
+	assert(n <= validate_lanes);
+	V->keys = n;
+	V->n = 0;
+	for (size_t j = 0; j < n; ++j) {
+		V->ok[j] = false;
+		if (!plausible(&in[j]))
+			continue;
+		V->idx[V->n] = j;
+		curve_set(&V->A[V->n++], &(proj) { in[j].A, fp_1 });
+	}
+	if (V->n)
+		validate_round(V);
+}
 
-			/* we only gain information if [(p+1)/l] P is non-zero */
-			if (memcmp(&P[i].z, &fp_0, sizeof(fp))) {
+/* walks the cofactor multiples [(p+1)/l] P for l in primes[lower, upper)
+ * depth first, starting with the large primes in primes[0], and stops as
+ * soon as every lane is decided. only the points on the current path are
+ * kept: the left half of a node goes on with its parent's points, the
+ * right half with the copy in V->path[depth]; divide and conquer is still
+ * much faster than doing it naively.
+ * at the root P still has z = 1 and the 2-power is left in the scalars,
+ * so that both ladders from it take the cheaper affine step. */
+bool validate_step(validate_state *V, unsigned int budget) {
+	while (V->n) {
+		if (!V->top || !V->undecided) {
+			/* P didn't have big enough order to prove supersingularity:
+			 * try again with the undecided keys only. */
+			size_t m = 0;
+			for (size_t j = 0; j < V->n; ++j) {
+				if (V->state[j]) {
+					V->ok[V->idx[j]] = V->state[j] > 0;
+				} else {
+					V->idx[m] = V->idx[j];
+					V->A[m++] = V->A[j];
+				}
+			}
+			V->n = m;
+			if (m)
+				validate_round(V);
+			continue;
+		}
 
-				u512 tmp;
-				u512_set(&tmp, primes[i]);
-				xMUL(&P[i], &A, &P[i], &tmp);
+		size_t depth = V->top - 1;
+		size_t lower = V->node[depth].lower, upper = V->node[depth].upper;
+		bool root = !depth;
+		proj *P = V->P;
+		for (size_t d = 0; d < depth; ++d)
+			if (V->node[d].side == 2)
+				P = V->path[d];
+
+		if (V->node[depth].side == 2) {
+			--V->top;
+			continue;
+		}
+		if (!budget)
+			return false;
+		--budget;
+
+		if (upper - lower == 1) {
+			validate_leaf(V, P, lower);
+			--V->top;
+			continue;
+		}
 
-				if (memcmp(&P[i].z, &fp_0, sizeof(fp)))
-					/* P does not have order dividing p+1. */
-					return false;
+		assert(depth < validate_depth);
+		size_t mid = lower + (upper - lower + 1) / 2;
 
-				u512_mul3_64(&order, &order, primes[i]);
+		u512 c = u512_1;
+		bool left = !V->node[depth].side;
+		for (size_t i = left ? mid : lower; i < (left ? upper : mid); ++i)
+			u512_mul3_64(&c, &c, primes[i]);
+		if (root) /* maximal 2-power in p+1 */
+			u512_mul3_64(&c, &c, 4);
 
-				if (u512_sub3(&tmp, &four_sqrt_p, &order)) /* returns borrow */
-					/* order > 4 sqrt(p), hence definitely supersingular */
-					return true;
-			}
+		/* the right half is only needed if the left one does not decide */
+		if (left) {
+			memcpy(V->path[depth], P, V->n * sizeof(proj));
+			xMUL_n_with(P, V->A, P, &c, V->n, root, V->ladder);
+		} else {
+			xMUL_n_with(V->path[depth], V->A, V->path[depth], &c, V->n, root, V->ladder);
 		}
+		V->node[depth].side = left ? 1 : 2;
+		V->node[V->top].lower = left ? lower : mid;
+		V->node[V->top].upper = left ? mid : upper;
+		V->node[V->top].side = 0;
+		++V->top;
+	}
+	return true;
+}
 
-		/* P didn't have big enough order to prove supersingularity. */
-	} while (1);
+void validate_finish(bool *ok, validate_state const *V) {
+	memcpy(ok, V->ok, V->keys * sizeof(bool));
+}
+
+/* never accepts invalid keys. */
+/* up to validate_lanes keys go through the ladders in lockstep. */
+void validate_batch_with(public_key const *in, bool *ok, size_t n, validate_state *V) {
+	for (size_t i = 0; i < n; i += validate_lanes) {
+		size_t m = n - i < validate_lanes ? n - i : validate_lanes;
+		validate_init(V, in + i, m);
+		while (!validate_step(V, UINT_MAX));
+		validate_finish(ok + i, V);
+	}
+}
+
+void validate_batch(public_key const *in, bool *ok, size_t n) {
+	validate_state V;
+	validate_batch_with(in, ok, n, &V);
+}
+
+bool validate_with(public_key const *in, validate_state *V) {
+	bool ok;
+	validate_batch_with(in, &ok, 1, V);
+	return ok;
+}
+
+bool validate(public_key const *in) {
+	validate_state V;
+	return validate_with(in, &V);
 }
 
 /* compute x^3 + Ax^2 + x */
@@ -152,7 +370,9 @@ static void montgomery_rhs(fp *rhs, fp const *A, fp const *x) {
 
 
 /* generates curve points */
-void elligator(proj *P, proj *Pd, const fp *A) {
+/* projective in A = (a : c); all coordinates carry an extra factor c,
+ * which turns the right-hand side into c^4 times the affine one. */
+void elligator(proj *P, proj *Pd, const proj *A) {
 
 	fp u2, u2m1, tmp, rhs;
 	bool issquare;
@@ -160,20 +380,21 @@ void elligator(proj *P, proj *Pd, const fp *A) {
 	fp_random(&u2);
 	fp_sq1(&u2);				// u^2
 	fp_sub3(&u2m1, &u2, &fp_1); // u^2 - 1
+	fp_mul2(&u2m1, &A->z);		// c(u^2 - 1)
 
-	fp_sq2(&tmp, &u2m1);	// (u^2 - 1)^2
-	fp_sq2(&rhs, A);		// A^2
-	fp_mul2(&rhs, &u2);		// A^2u^2
-	fp_add2(&rhs, &tmp);	// A^2u^2 + u(u^2 - 1)^2
-	fp_mul2(&rhs, A);		// (A^2u^2 + u(u^2 - 1)^2)A
-	fp_mul2(&rhs, &u2m1);	// (A^2u^2 + u(u^2 - 1)^2)A(u^2 - 1)
+	fp_sq2(&tmp, &u2m1);	// c^2(u^2 - 1)^2
+	fp_sq2(&rhs, &A->x);	// a^2
+	fp_mul2(&rhs, &u2);		// a^2u^2
+	fp_add2(&rhs, &tmp);	// a^2u^2 + c^2(u^2 - 1)^2
+	fp_mul2(&rhs, &A->x);	// (a^2u^2 + c^2(u^2 - 1)^2)a
+	fp_mul2(&rhs, &u2m1);	// (a^2u^2 + c^2(u^2 - 1)^2)ac(u^2 - 1)
 
 	fp_set(&P->x, 0);
-	fp_add2(&P->x, A);
+	fp_add2(&P->x, &A->x);
 	fp_set(&P->z, 0);
 	fp_add2(&P->z, &u2m1);
 	fp_set(&Pd->x, 0);
-	fp_sub2(&Pd->x, A);
+	fp_sub2(&Pd->x, &A->x);
 	fp_mul2(&Pd->x, &u2);
 	fp_set(&Pd->z, 0);
 	fp_add2(&Pd->z, &u2m1);
@@ -184,148 +405,329 @@ void elligator(proj *P, proj *Pd, const fp *A) {
 	fp_cswap(&P->z, &Pd->z, !issquare);
 }
 
-/* constant-time. */
-void action(public_key *out, public_key const *in, private_key const *priv,
+/* Q = (base_points[i ^ c] : 1) for c in {0, 1}, in constant time */
+static void base_point(proj *Q, size_t i, int c) {
+	fp T;
+	fp_enc(&Q->x, &base_points[i]);
+	fp_enc(&T, &base_points[i ^ 1]);
+	fp_cswap(&Q->x, &T, c);
+	Q->z = fp_1;
+}
+
+/* the factor k of round m: 4 times the primes of the other batches and
+ * the finished ones; only the finished ones once the batches are merged */
+static void round_factor(u512 *k, bool const *finished, uint8_t m, uint8_t num_batches) {
+	u512_set(k, 4);
+	for (uint8_t i = 0; i < num_primes; i++)
+		if (i % num_batches != m || finished[i])  //depends only on randomness
+			u512_mul3_64(k, k, primes[i]);
+}
+
+void action_init(action_state *st, public_key const *in, private_key const *priv,
 		uint8_t num_batches, int8_t const *max_exponent, unsigned int const num_isogenies, uint8_t const my) {
 
-	//factors k for different batches
-	u512 k[3] = {{ .c = {0x1b5933af628d005c, 0x9d4af02b1d7b7f56, 0x8977a8435092262a, 0xb86302ff54a37ca2, 0xd6e09db2af04d095, 0x5c73f, 0x0, 0x0} },
-				{.c = {0xd97b8b6bc6f6be1c, 0x315872c44ea6e448, 0x1aae7c54fd380c86, 0x237ec4cf2da454a2, 0x3733f9e3d9fea1b4, 0x1fdc0e, 0x0, 0x0} },
-				{.c = {0x629ea97b02169a84, 0xc4b9616a12d48d22, 0x492a10278ad7b45a, 0xc44ac4dce55b87f8, 0x9e12876886632d6e, 0xe0c0c5, 0x0, 0x0} }};
+	memset(st->finished, 0, sizeof(st->finished));
+	memcpy(st->e, priv->e, sizeof(priv->e));
+	memcpy(st->counter, max_exponent, sizeof(st->counter));
+
+	st->num_batches = num_batches;
+	st->my = my;
+	st->num_isogenies = num_isogenies;
+	st->isog_counter = 0;
+	st->count = 0;
+	st->m = 0;
+	st->in_round = false;
+
+#ifdef RADICAL
+	//the primes with radical formulas first, then they are done
+	fp a = in->A;
+	for (uint8_t i = 0; i < num_primes; i++) {
+		if (!radical_supported(primes[i]) || max_exponent[i] <= 0)
+			continue;
+		OPCOUNT_BEGIN(t_prime);
+		radical_isog(&a, primes[i], lookup(i, st->e), max_exponent[i]);
+		OPCOUNT_PRIME(i, t_prime);
+		st->finished[i] = true;
+		st->counter[i] = 0;
+		st->isog_counter += max_exponent[i];
+	}
+	curve_set(&st->A, &(proj) { a, fp_1 });
+#else
+	curve_set(&st->A, &(proj) { in->A, fp_1 });
+#endif
+}
 
+/* the points P and P' of the next round */
+static void round_begin(action_state *st) {
+	u512 k;
 
-	u512 p_order = { .c = {0x24403b2c196b9323, 0x8a8759a31723c208, 0xb4a93a543937992b, 0xcdd1f791dc7eb773, 0xff470bd36fd7823b, 0xfbcf1fc39d553409, 0x9478a78dd697be5c, 0x0ed9b5fb0f251816}};
+	st->m = (st->m + 1) % st->num_batches;
 
-	int8_t ec = 0, m = 0;
-	uint8_t count = 0;
-	uint8_t elligator_index = 0;
-	uint8_t last_iso[3], bc, ss;
-	proj P, Pd, K;
+	if (st->count == st->my * st->num_batches) {  //merge the batches after my rounds
+		st->m = 0;
+		st->num_batches = 1;  //doesn't skip point evaluations anymore after merging batches
+	}
+	//index for skipping point evaluations: the last prime of the batch
+	st->last_iso = st->m + (num_primes - 1 - st->m) / st->num_batches * st->num_batches;
+
+	//fixed-base first round on E_0: the multiples of p_order are precomputed.
+	//only round 0 is on a public curve, so only its elligator() and xMUL2()
+	//and the two ladders of its first prime are saved
+	st->from_base = st->count == 0 && st->num_batches == default_num_batches
+		&& !memcmp(&st->A.A.x, &fp_0, sizeof(fp));
+#ifdef RADICAL
+	st->from_base = false;  //the base points are for the full k
+#endif
+
+	OPCOUNT_BEGIN(t_elligator);
+	if (st->from_base) {
+		base_point(&st->P, 0, 0);  // [k]P
+		base_point(&st->Pd, 1, 0); // [k]P'
+	} else if(memcmp(&st->A.A.x, &fp_0, sizeof(fp))) {  //A = (0 : C) is the only projective zero
+		elligator(&st->P, &st->Pd, &st->A.A);
+	} else {
+		fp_enc(&st->P.x, &p_order); // point of full order on E_a with a=0
+		fp_sub3(&st->Pd.x, &fp_0, &st->P.x);
+		st->P.z = fp_1;
+		st->Pd.z = fp_1;
+	}
+	OPCOUNT_PHASE(OPCOUNT_ELLIGATOR, t_elligator);
+
+	OPCOUNT_BEGIN(t_xmul);
+	if (!st->from_base) {
+		round_factor(&k, st->finished, st->m, st->num_batches);
+		xMUL2(&st->P, &st->Pd, &st->A, &st->P, &st->Pd, &k);
+	}
+	OPCOUNT_PHASE(OPCOUNT_XMUL, t_xmul);
+	st->ps = 1;
+	st->i = st->m;
+	st->in_round = true;
+}
+
+/* one isogeny of degree primes[i], real or dummy; constant-time */
+static void round_prime(action_state *st, uint8_t i) {
+	int8_t ec, s;
+	uint8_t bc, ss;
+	proj K;
 	u512 cof, l;
-	bool finished[num_primes] = {0};
-	int8_t e[num_primes] = {0};
-	int8_t counter[num_primes] = {0};
-	int8_t s, ps;
-	unsigned int isog_counter = 0;
-
-	//index for skipping point evaluations
-	last_iso[0] = 72;
-	last_iso[1] = 73;
-	last_iso[2] = 71;
-
-	memcpy(e, priv->e, sizeof(priv->e));
-
-	memcpy(counter, max_exponent, sizeof(counter));
-
-	proj A = { in->A, fp_1 };
-
-	while (isog_counter < num_isogenies) {
-		m = (m + 1) % num_batches;
-		
-		if(count == my*num_batches) {  //merge the batches after my rounds
-			m = 0;
-			last_iso[0] = 73;    //doesn't skip point evaluations anymore after merging batches
-			u512_set(&k[m], 4);  //recompute factor k
-			num_batches = 1;
-
-			// no need for constant-time, depends only on randomness
-			for (uint8_t i = 0; i < num_primes; i++) {
-				if(counter[i]==0) {
-					u512_mul3_64(&k[m], &k[m], primes[i]);
-				}
-			}
-		}
 
-		assert(!memcmp(&A.z, &fp_1, sizeof(fp)));
+	OPCOUNT_BEGIN(t_prime);
+	cof = u512_1;
+	for (uint8_t j = i + st->num_batches; j < num_primes; j = j + st->num_batches) {
+		if (st->finished[j] == false)  //depends only on randomness
+			u512_mul3_64(&cof, &cof, primes[j]);
+	}
 
-		if(memcmp(&A.x, &fp_0, sizeof(fp))) {
-			elligator(&P, &Pd, &A.x);
-		} else {
-			fp_enc(&P.x, &p_order); // point of full order on E_a with a=0
-			fp_sub3(&Pd.x, &fp_0, &P.x);
-			P.z = fp_1;
-			Pd.z = fp_1;
-		}
+	ec = lookup(i, st->e);  //check in constant-time if normal or dummy isogeny must be computed
+	bc = isequal(ec, 0);
+	s = (uint8_t)ec >> 7;
+	ss = !isequal(s, st->ps);
+	st->ps = s;
+
+	fp_cswap(&st->P.x, &st->Pd.x, ss);
+	fp_cswap(&st->P.z, &st->Pd.z, ss);
+	OPCOUNT_BEGIN(t_cofactor);
+	if (st->from_base && i == st->m) {  //first prime, still on E_0
+		base_point(&K, 2, ss);  // [c k]P or [c k]P'
+		base_point(&st->Pd, 5, ss); // [l k]P' or [l k]P
+	} else {
+		xMUL(&K, &st->A, &st->P, &cof);
+		u512_set(&l, primes[i]);
+		xMUL(&st->Pd, &st->A, &st->Pd, &l);
+	}
+	OPCOUNT_PHASE(OPCOUNT_COFACTOR, t_cofactor);
 
-		xMUL(&P, &A, &P, &k[m]);
-		xMUL(&Pd, &A, &Pd, &k[m]);
-		ps = 1;
+	if (memcmp(&K.z, &fp_0, sizeof(fp))) {  //depends only on randomness
 
-		for (uint8_t i = m; i < num_primes; i = i + num_batches) {
-			if(finished[i] == true) {  //depends only on randomness
-				continue;
-			} else {
-				cof = u512_1;
-				for (uint8_t j = i + num_batches; j < num_primes; j = j + num_batches) {
-					if (finished[j] == false)  //depends only on randomness
-						u512_mul3_64(&cof, &cof, primes[j]);
-				}
+		if (i == st->last_iso)
+		{
+			OPCOUNT_TIME(OPCOUNT_LASTXISOG, lastxISOG(&st->A, &K, primes[i], bc));	// doesn't compute the images of points
+		}
+		else
+		{
+			OPCOUNT_TIME(OPCOUNT_XISOG, xISOG(&st->A, &st->P, &st->Pd, &K, primes[i], bc));
+		}
 
-				ec = lookup(i, e);  //check in constant-time if normal or dummy isogeny must be computed
-				bc = isequal(ec, 0);
-				s = (uint8_t)ec >> 7;
-				ss = !isequal(s, ps);
-				ps = s;
+		update(i, st->e, ec - (1 ^ bc) + (s << 1));
+		st->counter[i] = st->counter[i] - 1;
+		st->isog_counter = st->isog_counter + 1;
+	}
+	OPCOUNT_PRIME(i, t_prime);
 
-				fp_cswap(&P.x, &Pd.x, ss);
-				fp_cswap(&P.z, &Pd.z, ss);
-				xMUL(&K, &A, &P, &cof);
-				u512_set(&l, primes[i]);
-				xMUL(&Pd, &A, &Pd, &l);
+	if (st->counter[i] == 0)   //depends only on randomness
+		st->finished[i] = true;
+}
 
-				if (memcmp(&K.z, &fp_0, sizeof(fp))) {  //depends only on randomness
+/* constant-time. */
+bool action_step(action_state *st, unsigned int budget) {
+	while (budget) {
+		if (!st->in_round) {
+			if (st->isog_counter >= st->num_isogenies)
+				return true;
+			round_begin(st);
+			--budget;
+			continue;
+		}
 
-						if (i == last_iso[m])
-						{
-							lastxISOG(&A, &K, primes[i], bc);	// doesn't compute the images of points
-						}
-						else
-						{
-							xISOG(&A, &P, &Pd, &K, primes[i], bc);
-						}
+		if (st->i >= num_primes) {
+			st->count = st->count + 1;
+			st->in_round = false;
+			continue;
+		}
 
-						e[i] = ec - (1 ^ bc) + (s << 1);
-						counter[i] = counter[i] - 1;
-						isog_counter = isog_counter + 1;
+		uint8_t i = st->i;
+		st->i = i + st->num_batches;
+		if (st->finished[i])  //depends only on randomness
+			continue;
+		round_prime(st, i);
+		--budget;
+	}
+	return !st->in_round && st->isog_counter >= st->num_isogenies;
+}
 
+void action_finish(public_key *out, action_state *st) {
+	OPCOUNT_BEGIN(t_normalize);
+	fp_inv(&st->A.A.z);
+	fp_mul3(&out->A, &st->A.A.x, &st->A.A.z);
+	OPCOUNT_PHASE(OPCOUNT_NORMALIZE, t_normalize);
 
+	zeroize(st, sizeof(*st));  //the exponents, but also the curves and points on the way
+}
 
-				}
+/* constant-time. */
+void action_with(public_key *out, public_key const *in, private_key const *priv,
+		uint8_t num_batches, int8_t const *max_exponent, unsigned int const num_isogenies, uint8_t const my,
+		csidh_scratch *scratch) {
+	action_init(&scratch->action, in, priv, num_batches, max_exponent, num_isogenies, my);
+	while (!action_step(&scratch->action, UINT_MAX));
+	action_finish(out, &scratch->action);
+}
 
-			}
+void action(public_key *out, public_key const *in, private_key const *priv,
+		uint8_t num_batches, int8_t const *max_exponent, unsigned int const num_isogenies, uint8_t const my) {
+	action_state st;
+	action_init(&st, in, priv, num_batches, max_exponent, num_isogenies, my);
+	while (!action_step(&st, UINT_MAX));
+	action_finish(out, &st);
+}
 
+/* NOT constant-time: the running time and the isogenies computed depend on
+ * the exponents. only for public exponent vectors, e.g. the reduced vectors
+ * of class-group relations; never call it with a private key.
+ * no dummies and no batches: every round takes both points of one Elligator
+ * sample, one for the positive and one for the negative exponents, so it
+ * takes about max |e_i| rounds. the
+ * primes go in descending order, the cheap ladders for the small cofactors
+ * of the large primes come first. */
+void action_vartime(public_key *out, public_key const *in, private_key const *priv) {
+	uint8_t order[num_primes];
+	int8_t e[num_primes];
+	curve E;
+	proj P[2], K;
+	u512 k;
+
+	for (uint8_t i = 0; i < num_primes; i++) {
+		uint8_t j = i;
+		for (; j > 0 && primes[order[j - 1]] < primes[i]; j--)
+			order[j] = order[j - 1];
+		order[j] = i;
+	}
 
-			if(counter[i]==0) {   //depends only on randomness
-				finished[i] = true;
-				u512_mul3_64(&k[m], &k[m], primes[i]);
-			}
-		}
+	memcpy(e, priv->e, sizeof(e));
+	curve_set(&E, &(proj) { in->A, fp_1 });
 
+	for (;;) {
+		bool todo[2] = { false, false };
+		for (uint8_t i = 0; i < num_primes; i++)
+			todo[e[i] < 0] |= e[i] != 0;
+		if (!todo[0] && !todo[1])
+			break;
 
+		//P[0] for e_i > 0, P[1] for e_i < 0, the same choice as round_prime()
+		if (memcmp(&E.A.x, &fp_0, sizeof(fp))) {
+			elligator(&P[1], &P[0], &E.A);
+		} else {
+			fp_enc(&P[1].x, &p_order);
+			fp_sub3(&P[0].x, &fp_0, &P[1].x);
+			P[0].z = fp_1;
+			P[1].z = fp_1;
+		}
 
+		for (int s = 0; s < 2; s++) {
+			if (!todo[s])
+				continue;
+			u512_set(&k, 4);
+			for (uint8_t i = 0; i < num_primes; i++)
+				if (!e[i] || (e[i] < 0) != s)
+					u512_mul3_64(&k, &k, primes[i]);
+			xMUL(&P[s], &E, &P[s], &k);
+		}
 
-		fp_inv(&A.z);
-		fp_mul2(&A.x, &A.z);
-		A.z = fp_1;
-		count = count + 1;
+		for (int s = 0; s < 2; s++) {
+			if (!todo[s])
+				continue;
+			for (uint8_t j = 0; j < num_primes; j++) {
+				uint8_t i = order[j];
+				if (!e[i] || (e[i] < 0) != s)
+					continue;
+
+				bool more = false;
+				u512 cof = u512_1;
+				for (uint8_t l = j + 1; l < num_primes; l++) {
+					if (e[order[l]] && (e[order[l]] < 0) == s) {
+						u512_mul3_64(&cof, &cof, primes[order[l]]);
+						more = true;
+					}
+				}
 
+				xMUL(&K, &E, &P[s], &cof);
+				if (!memcmp(&K.z, &fp_0, sizeof(fp)))
+					continue;  //no point of order primes[i] this round
+
+				//push the points that are still needed through the isogeny
+				proj Q[2];
+				size_t n = 0;
+				if (more)
+					Q[n++] = P[s];
+				if (s == 0 && todo[1])
+					Q[n++] = P[1];
+				if (n)
+					xISOG_n(&E, Q, n, &K, primes[i], 0);
+				else
+					lastxISOG(&E, &K, primes[i], 0);
+				n = 0;
+				if (more)
+					P[s] = Q[n++];
+				if (s == 0 && todo[1])
+					P[1] = Q[n++];
+
+				e[i] += s ? 1 : -1;
+			}
+		}
 	}
 
-	out->A = A.x;
-
+	fp_inv(&E.A.z);
+	fp_mul3(&out->A, &E.A.x, &E.A.z);
 }
 
 
 /* includes public-key validation. */
-bool csidh(public_key *out, public_key const *in, private_key const *priv,
-		uint8_t const num_batches, int8_t const *max_exponent, unsigned int const num_isogenies, uint8_t const my) {
-	if (!validate(in)) {
+bool csidh_with(public_key *out, public_key const *in, private_key const *priv,
+		uint8_t const num_batches, int8_t const *max_exponent, unsigned int const num_isogenies, uint8_t const my,
+		csidh_scratch *scratch) {
+	if (!validate_with(in, &scratch->validate)) {
 		fp_random(&out->A);
 		return false;
 	}
-	action(out, in, priv, num_batches, max_exponent, num_isogenies, my);
+	action_with(out, in, priv, num_batches, max_exponent, num_isogenies, my, scratch);
 
 	return true;
 }
 
+bool csidh(public_key *out, public_key const *in, private_key const *priv,
+		uint8_t const num_batches, int8_t const *max_exponent, unsigned int const num_isogenies, uint8_t const my) {
+	csidh_scratch scratch;
+	return csidh_with(out, in, priv, num_batches, max_exponent, num_isogenies, my, &scratch);
+}
+
 
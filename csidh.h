@@ -5,11 +5,20 @@
 #include "fp.h"
 #include "mont.h"
 
-/* specific to p, should perhaps be somewhere else */
-#define num_primes 74
-fp invs_[9];
+extern fp invs_[9];
 
-const unsigned primes[num_primes];
+/* specific to p, defined in p512.c or the generated parameter files */
+extern const unsigned primes[num_primes];
+extern const int8_t default_max[num_primes];
+extern const u512 four_sqrt_p;
+extern const u512 p_order;
+/* the first round of action() from E_0 with default_num_batches batches:
+ * [k]P, [k]P', [c k]P, [c k]P', [l k]P, [l k]P' for P = (p_order, .),
+ * P' = -P on the twist, the batch factor k, and the cofactor c and degree l
+ * of the first prime of the batch. this covers round 0 only, and of its
+ * ladders only the round points and those of its first prime; every later
+ * round starts from a curve that depends on the key */
+extern const u512 base_points[6];
 
 typedef struct private_key {
     int8_t e[num_primes];
@@ -21,18 +30,115 @@ typedef struct public_key {
 
 extern const public_key base;
 
+/* the state of action() between calls of action_step(): event loops can
+ * interleave many actions with a bounded amount of work per call. */
+typedef struct action_state {
+    bool finished[num_primes];
+    int8_t e[num_primes];   /* secret; action_finish() clears the whole state */
+    int8_t counter[num_primes];
+    curve A;
+    proj P, Pd;             /* the points of the current round */
+    unsigned int isog_counter, num_isogenies;
+    uint8_t num_batches, my;
+    uint8_t count, m, i;    /* round, its batch, the next prime */
+    uint8_t last_iso;
+    int8_t ps;
+    bool from_base, in_round;
+} action_state;
+
+/* number of keys validate_batch() processes in lockstep: the 16 products
+ * of a ladder step fill two fp_mul8 calls. */
+#define validate_lanes 4
+/* the levels of validate()'s walk, log2(num_primes) rounded up */
+#define validate_depth (num_primes <= 16 ? 4 : num_primes <= 32 ? 5 : num_primes <= 64 ? 6 : \
+        num_primes <= 128 ? 7 : 8)
+
+/* the state of validate_batch() between calls of validate_step(): the
+ * keys that are validated in lockstep, the nodes of the walk from the root
+ * to the current one, the points that wait for the right half of their
+ * node and the temporaries of the ladders */
+typedef struct validate_state {
+    size_t keys, n, undecided;    /* of validate_init(), still in the walk */
+    curve A[validate_lanes];
+    u512 order[validate_lanes];
+    int8_t state[validate_lanes]; /* 0 undecided, 1 supersingular, -1 invalid */
+    size_t idx[validate_lanes];   /* the key of each lane */
+    bool ok[validate_lanes];      /* the result for each key */
+    struct {
+        size_t lower, upper;      /* primes[lower, upper) */
+        uint8_t side;             /* 0 not started, 1 left half, 2 right half */
+    } node[validate_depth + 1];
+    size_t top;                   /* nodes on the path, 0 between rounds */
+    proj P[validate_lanes];
+    proj path[validate_depth][validate_lanes];
+    ladder_lane ladder[validate_lanes];
+} validate_state;
+
+/* the scratch buffer of the *_with() variants; csidh_with() validates
+ * before the action starts, so both use the same memory */
+typedef union csidh_scratch {
+    validate_state validate;
+    action_state action;
+} csidh_scratch;
+
+/* the most stack any entry point takes for CSIDH-512 with gcc -O3; ./stack
+ * fails if one of them takes more. the *_with() variants keep their state
+ * and the ladder and isogeny temporaries that grow with the number of
+ * points in the caller's buffer; what is left on the stack is mostly the
+ * fixed frames of the field arithmetic. the others have that buffer on
+ * their stack, ctidh() the largest at about 26 KiB. */
+#define csidh_stack_with_max 8192
+#define csidh_stack_max 32768
+
 void csidh_private(private_key *priv, const int8_t *max_exponent);
 void action(public_key *out, public_key const *in, private_key const *priv,
 		uint8_t num_intervals, int8_t const *max_exponent, unsigned int const num_isogenies, uint8_t const my);
 bool csidh(public_key *out, public_key const *in, private_key const *priv,
 		uint8_t const num_intervals, int8_t const *max_exponent, unsigned int const num_isogenies, uint8_t const my);
-void elligator(proj *P, proj *Pd, const fp *A);
+void elligator(proj *P, proj *Pd, const proj *A);
 bool validate(public_key const *in);
+void validate_batch(public_key const *in, bool *ok, size_t n);
+bool validate_with(public_key const *in, validate_state *st);
+void validate_batch_with(public_key const *in, bool *ok, size_t n, validate_state *st);
+
+void action_with(public_key *out, public_key const *in, private_key const *priv,
+		uint8_t num_intervals, int8_t const *max_exponent, unsigned int const num_isogenies, uint8_t const my,
+		csidh_scratch *scratch);
+bool csidh_with(public_key *out, public_key const *in, private_key const *priv,
+		uint8_t const num_intervals, int8_t const *max_exponent, unsigned int const num_isogenies, uint8_t const my,
+		csidh_scratch *scratch);
+
+/* action() in steps: action_step() does at most budget units of work, one
+ * unit being a round's fresh points or one isogeny (about a millisecond at
+ * most for p512), and returns true once all isogenies are done.
+ * action_finish() writes the result and zeroes all of the state, the
+ * intermediate curve and points included; call it also to abandon an
+ * action. */
+void action_init(action_state *st, public_key const *in, private_key const *priv,
+		uint8_t num_intervals, int8_t const *max_exponent, unsigned int const num_isogenies, uint8_t const my);
+bool action_step(action_state *st, unsigned int budget);
+void action_finish(public_key *out, action_state *st);
+
+/* validate_batch() in steps, for up to validate_lanes keys: validate_step()
+ * does at most budget ladders, one unit each (a fraction of a millisecond
+ * for p512), and returns true once every key is decided. validate_finish()
+ * writes the results to ok[0..n) for the n of validate_init(). */
+void validate_init(validate_state *st, public_key const *in, size_t n);
+bool validate_step(validate_state *st, unsigned int budget);
+void validate_finish(bool *ok, validate_state const *st);
+
+/* variable time, for public exponent vectors only: never with a secret key.
+ * the same result as action() for exponents within max_exponent. */
+void action_vartime(public_key *out, public_key const *in, private_key const *priv);
 
 
 int32_t lookup(size_t pos, int8_t const *priv);
+void update(size_t pos, int8_t *priv, int8_t v);
+int32_t lookup_scalar(size_t pos, int8_t const *priv);  /* the reference for the vector ones */
+void update_scalar(size_t pos, int8_t *priv, int8_t v);
 uint32_t isequal(uint32_t a, uint32_t b);
 void cmov(int8_t *r, const int8_t *a, uint32_t b);
+void zeroize(void *x, size_t l);
 
 
 #endif
@@ -0,0 +1,374 @@
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/resource.h>
+
+#include "csidh.h"
+#include "keypool.h"
+#include "wire.h"
+
+/* key-exchange daemon for load tests, see wire.h for the framing and
+ * loadgen.c for the client. every exchange takes an ephemeral key pair
+ * from the key pool (or generates one inline when the pool is empty),
+ * validates the client's key and computes the shared secret, then answers
+ * with the ephemeral public key. the shared secret is dropped, a real
+ * service would derive its session keys from it.
+ * each thread runs an event loop over its connections and interleaves
+ * their validations and actions with validate_step() and action_step(),
+ * budget units at a time, so that one exchange does not hold up the others.
+ * the threads share the listening socket and take one new connection per
+ * wakeup, so that a burst of them spreads over the threads.
+ * usage: ./csidhd [-s socket] [-t threads] [-c connections per thread]
+ *                 [-p pool capacity] [-r refill threads] [-b budget] */
+
+static uint8_t num_batches = default_num_batches;
+static uint8_t my = default_my;
+static unsigned int num_isogenies = default_num_isogenies;
+
+static int8_t const *max = default_max;
+
+enum phase { READING, VALIDATING, KEYGEN, SHARED, WRITING };
+
+typedef struct conn {
+	int fd;
+	enum phase phase;
+	uint8_t buf[wire_header_len + wire_max_len];
+	size_t len, want;           /* bytes in buf, bytes of the current frame */
+	public_key in;
+	keypool_entry eph;
+	csidh_scratch st;           /* the validation, then the actions */
+} conn;
+
+static int listen_fd;
+static unsigned int max_conns = 256;
+static unsigned int budget = 8;
+static keypool pool;
+static bool use_pool;
+static volatile sig_atomic_t stop;
+static _Atomic uint64_t exchanges, invalid, connections;
+
+static void on_signal(int sig) { (void) sig; stop = 1; }
+
+static uint64_t cpu_ns(void) {
+	struct rusage ru;
+	getrusage(RUSAGE_SELF, &ru);
+	return (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1000000000ull
+		+ (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) * 1000ull;
+}
+
+static void respond(conn *c, uint8_t type, uint8_t status, uint16_t len) {
+	wire_put_header(c->buf, type, status, len);
+	c->want = wire_header_len + len;
+	c->len = 0;
+	c->phase = WRITING;
+}
+
+static void stats(conn *c) {
+	wire_stats s = {
+		.exchanges = atomic_load(&exchanges),
+		.invalid = atomic_load(&invalid),
+		.cpu_ns = cpu_ns(),
+		.connections = atomic_load(&connections),
+	};
+	if (use_pool) {
+		keypool_stats ps;
+		keypool_stats_get(&pool, &ps);
+		s.pool_taken = ps.taken;
+		s.pool_misses = ps.misses;
+	} else {
+		s.pool_misses = s.exchanges - s.invalid;  //every key is generated inline
+	}
+	wire_put_stats(c->buf + wire_header_len, &s);
+	respond(c, WIRE_STATS, WIRE_OK, wire_stats_len);
+}
+
+static void reject(conn *c) {
+	atomic_fetch_add(&exchanges, 1);
+	atomic_fetch_add(&invalid, 1);
+	respond(c, WIRE_EXCHANGE, WIRE_INVALID_KEY, 0);
+}
+
+/* a whole request is in the buffer; false hangs up */
+static bool dispatch(conn *c) {
+	uint8_t type, status;
+	uint16_t len;
+	wire_get_header(c->buf, &type, &status, &len);
+
+	if (type == WIRE_STATS && !len) {
+		stats(c);
+		return true;
+	}
+	if (type != WIRE_EXCHANGE || len != wire_key_len)
+		return false;
+
+	if (!wire_get_key(&c->in, c->buf + wire_header_len)) {
+		reject(c);
+		return true;
+	}
+	validate_init(&c->st.validate, &c->in, 1);
+	c->phase = VALIDATING;
+	return true;
+}
+
+static bool computing(conn const *c) {
+	return c->phase == VALIDATING || c->phase == KEYGEN || c->phase == SHARED;
+}
+
+static void compute(conn *c) {
+	public_key out;
+	bool ok;
+
+	if (c->phase == VALIDATING) {
+		if (!validate_step(&c->st.validate, budget))
+			return;
+		validate_finish(&ok, &c->st.validate);
+		if (!ok) {
+			reject(c);
+			return;
+		}
+		if (use_pool && keypool_take(&pool, &c->eph)) {
+			action_init(&c->st.action, &c->in, &c->eph.priv, num_batches, max, num_isogenies, my);
+			c->phase = SHARED;
+		} else {
+			csidh_private(&c->eph.priv, max);
+			action_init(&c->st.action, &base, &c->eph.priv, num_batches, max, num_isogenies, my);
+			c->phase = KEYGEN;
+		}
+		return;
+	}
+
+	if (!action_step(&c->st.action, budget))
+		return;
+	action_finish(&out, &c->st.action);
+
+	if (c->phase == KEYGEN) {
+		c->eph.pub = out;
+		action_init(&c->st.action, &c->in, &c->eph.priv, num_batches, max, num_isogenies, my);
+		c->phase = SHARED;
+		return;
+	}
+
+	zeroize(&out, sizeof(out));  /* the shared secret */
+	wire_put_key(c->buf + wire_header_len, &c->eph.pub);
+	keypool_release(&c->eph);
+	atomic_fetch_add(&exchanges, 1);
+	respond(c, WIRE_EXCHANGE, WIRE_OK, wire_key_len);
+}
+
+/* false hangs up */
+static bool readable(conn *c) {
+	for (;;) {
+		ssize_t n = recv(c->fd, c->buf + c->len, c->want - c->len, 0);
+		if (n < 0)
+			return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+		if (!n)
+			return false;
+		c->len += n;
+		if (c->len < c->want)
+			continue;
+		if (c->want == wire_header_len) {
+			uint8_t type, status;
+			uint16_t len;
+			wire_get_header(c->buf, &type, &status, &len);
+			if (len > wire_max_len)
+				return false;
+			c->want += len;
+			if (len)
+				continue;
+		}
+		return dispatch(c);
+	}
+}
+
+static bool writable(conn *c) {
+	while (c->len < c->want) {
+		ssize_t n = send(c->fd, c->buf + c->len, c->want - c->len, MSG_NOSIGNAL);
+		if (n < 0)
+			return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+		c->len += n;
+	}
+	c->phase = READING;
+	c->len = 0;
+	c->want = wire_header_len;
+	return true;
+}
+
+static void hang_up(conn *c) {
+	close(c->fd);
+	if (c->phase == KEYGEN || c->phase == SHARED) {
+		public_key out;
+		action_finish(&out, &c->st.action);
+	}
+	keypool_release(&c->eph);
+	zeroize(c, sizeof(*c));
+	c->fd = -1;
+}
+
+static void *serve(void *arg) {
+	(void) arg;
+	conn *conns = calloc(max_conns, sizeof(*conns));
+	struct pollfd *fds = calloc(max_conns + 1, sizeof(*fds));
+	size_t *which = calloc(max_conns + 1, sizeof(*which));
+	unsigned int num_conns = 0;
+
+	if (!conns || !fds || !which) {
+		fprintf(stderr, "out of memory\n");
+		exit(1);
+	}
+	for (size_t i = 0; i < max_conns; ++i)
+		conns[i].fd = -1;
+
+	while (!stop) {
+		nfds_t nfds = 0;
+		bool busy = false;
+
+		if (num_conns < max_conns)
+			fds[nfds++] = (struct pollfd) { .fd = listen_fd, .events = POLLIN };
+		for (size_t i = 0; i < max_conns; ++i) {
+			conn *c = &conns[i];
+			if (c->fd < 0)
+				continue;
+			if (computing(c)) {
+				busy = true;
+				continue;
+			}
+			which[nfds] = i;
+			fds[nfds++] = (struct pollfd) { .fd = c->fd, .events = c->phase == READING ? POLLIN : POLLOUT };
+		}
+
+		if (poll(fds, nfds, busy ? 0 : 500) < 0 && errno != EINTR)
+			break;
+
+		for (nfds_t k = 0; k < nfds; ++k) {
+			if (!fds[k].revents)
+				continue;
+			if (fds[k].fd == listen_fd) {
+				/* one at a time: the other threads that woke up take the rest */
+				int fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK);
+				if (fd >= 0) {
+					size_t i = 0;
+					while (conns[i].fd >= 0)
+						++i;
+					conns[i] = (conn) { .fd = fd, .phase = READING, .want = wire_header_len };
+					++num_conns;
+					atomic_fetch_add(&connections, 1);
+				}
+				continue;
+			}
+			conn *c = &conns[which[k]];
+			bool ok = !(fds[k].revents & (POLLERR | POLLNVAL));
+			if (ok && c->phase == READING)
+				ok = readable(c);
+			else if (ok && c->phase == WRITING)
+				ok = writable(c);
+			if (!ok) {
+				hang_up(c);
+				--num_conns;
+			}
+		}
+
+		for (size_t i = 0; i < max_conns; ++i)
+			if (conns[i].fd >= 0 && computing(&conns[i]))
+				compute(&conns[i]);
+	}
+
+	for (size_t i = 0; i < max_conns; ++i)
+		if (conns[i].fd >= 0)
+			hang_up(&conns[i]);
+	free(conns);
+	free(fds);
+	free(which);
+	return NULL;
+}
+
+int main(int argc, char **argv) {
+	char const *path = "csidhd.sock";
+	unsigned int num_threads = 1;
+	keypool_params params = {
+		.capacity = 64,
+		.num_threads = 1,
+		.num_batches = num_batches,
+		.max_exponent = max,
+		.num_isogenies = num_isogenies,
+		.my = my,
+	};
+	int opt;
+
+	while ((opt = getopt(argc, argv, "s:t:c:p:r:b:")) != -1) {
+		switch (opt) {
+		case 's': path = optarg; break;
+		case 't': num_threads = strtoul(optarg, NULL, 10); break;
+		case 'c': max_conns = strtoul(optarg, NULL, 10); break;
+		case 'p': params.capacity = strtoul(optarg, NULL, 10); break;
+		case 'r': params.num_threads = strtoul(optarg, NULL, 10); break;
+		case 'b': budget = strtoul(optarg, NULL, 10); break;
+		default:
+			fprintf(stderr, "usage: %s [-s socket] [-t threads] [-c connections per thread] "
+					"[-p pool capacity] [-r refill threads] [-b budget]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (!num_threads || !max_conns || !budget) {
+		fprintf(stderr, "need threads, connections and budget > 0\n");
+		return 1;
+	}
+
+	use_pool = params.capacity && params.num_threads;
+	if (use_pool) {
+		params.low_watermark = params.capacity / 4;
+		params.high_watermark = params.capacity;
+		if (!keypool_init(&pool, &params)) {
+			fprintf(stderr, "cannot start the key pool\n");
+			return 1;
+		}
+	}
+
+	struct sockaddr_un addr = { .sun_family = AF_UNIX };
+	if (strlen(path) >= sizeof(addr.sun_path)) {
+		fprintf(stderr, "socket path too long\n");
+		return 1;
+	}
+	strcpy(addr.sun_path, path);
+	unlink(path);
+	listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+	if (listen_fd < 0 || bind(listen_fd, (struct sockaddr *) &addr, sizeof(addr))
+			|| listen(listen_fd, SOMAXCONN)) {
+		perror(path);
+		return 1;
+	}
+
+	struct sigaction sa = { .sa_handler = on_signal };
+	sigaction(SIGINT, &sa, NULL);
+	sigaction(SIGTERM, &sa, NULL);
+
+	fprintf(stderr, "listening on %s: %u threads, %u connections each, pool of %zu keys, budget %u\n",
+			path, num_threads, max_conns, use_pool ? pool.params.capacity : 0, budget);
+
+	pthread_t threads[num_threads];
+	for (unsigned int i = 1; i < num_threads; ++i)
+		if (pthread_create(&threads[i], NULL, serve, NULL)) {
+			fprintf(stderr, "cannot start thread %u\n", i);
+			return 1;
+		}
+	serve(NULL);
+	for (unsigned int i = 1; i < num_threads; ++i)
+		pthread_join(threads[i], NULL);
+
+	close(listen_fd);
+	unlink(path);
+	if (use_pool)
+		keypool_destroy(&pool);
+	fprintf(stderr, "%lu exchanges, %lu invalid keys, %lu connections\n",
+			(unsigned long) exchanges, (unsigned long) invalid, (unsigned long) connections);
+	return 0;
+}
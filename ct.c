@@ -0,0 +1,269 @@
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <sched.h>
+
+#include "u512.h"
+#include "fp.h"
+#include "mont.h"
+#include "csidh.h"
+#include "ctidh.h"
+#include "rng.h"
+#include "cycle.h"
+
+/* timing leakage detection in the style of dudect:
+ * every target is run on inputs of two classes, a fixed one and a random
+ * one, in random order. Welch's t-test is applied to the two cycle
+ * distributions, as measured and cropped at a few percentiles to discard
+ * interrupts. |t| above the threshold means the timing depends on the
+ * class, i.e. on the secret. Both classes are prepared by the same
+ * branch-free code, so that only the input differs; a mispredicted
+ * branch right before the timed region shows up in the t-statistic.
+ * usage: ./ct [-t threshold] [-s scale] [filter] */
+
+static uint8_t num_batches = default_num_batches;
+static uint8_t my = default_my;
+static unsigned int num_isogenies = default_num_isogenies;
+
+static int8_t const *max = default_max;
+
+typedef struct target {
+	char const *name;
+	unsigned long measurements;
+	void (*prepare)(bool fixed); /* not timed */
+	void (*run)(void);
+} target;
+
+
+/* inputs of the current measurement */
+static struct {
+	fp x, y;
+	proj P, Q;
+	curve E;
+	u512 k;
+	size_t pos;
+	int8_t e[num_primes];
+	private_key priv;
+	public_key pub;
+} in;
+
+static fp fixed_fp;
+static private_key fixed_priv, fixed_ctidh_priv;
+static curve E0;
+
+/* overwrite x by the fixed value without branching on the class */
+static void select_fixed(void *x, void const *fixed_value, size_t l, bool fixed) {
+	uint8_t mask = -(uint8_t) fixed;
+	for (size_t i = 0; i < l; ++i)
+		((uint8_t *) x)[i] ^= (((uint8_t *) x)[i] ^ ((uint8_t const *) fixed_value)[i]) & mask;
+}
+
+
+static void prepare_fp(bool fixed) {
+	fp_random(&in.y);
+	fp_random(&in.x);
+	select_fixed(&in.x, &fixed_fp, sizeof(in.x), fixed);
+}
+static void run_fp_mul3(void) { fp_mul3(&in.y, &in.x, &in.y); }
+static void run_fp_sq2(void) { fp_sq2(&in.y, &in.x); }
+static void run_fp_mul4(void) {
+	fp *x[4] = { &in.y, &in.y, &in.y, &in.y };
+	fp const *y[4] = { &in.x, &in.x, &in.x, &in.x };
+	fp const *z[4] = { &in.y, &in.x, &in.y, &in.x };
+	fp_mul4(x, y, z, 4);
+}
+static void run_fp_mul8(void) {
+	fp *x[8] = { &in.y, &in.y, &in.y, &in.y, &in.y, &in.y, &in.y, &in.y };
+	fp const *y[8] = { &in.x, &in.x, &in.x, &in.x, &in.x, &in.x, &in.x, &in.x };
+	fp const *z[8] = { &in.y, &in.x, &in.y, &in.x, &in.y, &in.x, &in.y, &in.x };
+	fp_mul8(x, y, z, 8);
+}
+static void run_fp_inv(void) { fp_inv(&in.x); }
+static void run_fp_issquare(void) { in.y.x.c[0] ^= fp_issquare(&in.x); }
+
+static void prepare_lookup(bool fixed) {
+	randombytes(in.e, sizeof(in.e));
+	randombytes(&in.pos, sizeof(in.pos));
+	in.pos %= num_primes;
+	select_fixed(&in.pos, &(size_t) { 0 }, sizeof(in.pos), fixed);
+}
+static void run_lookup(void) { in.e[0] ^= lookup(in.pos, in.e); }
+static void run_update(void) { update(in.pos, in.e, 1); }
+
+static void prepare_xmul(bool fixed) {
+	in.E = E0;
+	elligator(&in.P, &in.Q, &in.E.A);
+	fp_random((fp *) &in.k);
+	select_fixed(&in.k, &u512_1, sizeof(in.k), fixed);
+}
+static void run_xMUL_ct(void) { xMUL_ct(&in.Q, &in.E, &in.P, &in.k, PBITS); }
+static void run_xMUL_ct_n(void) {
+	curve E[2] = { in.E, in.E };
+	proj P[2] = { in.P, in.Q };
+	u512 k[2] = { in.k, u512_1 };
+	xMUL_ct_n(P, E, P, k, PBITS, 2);
+}
+
+static void prepare_action(bool fixed) {
+	csidh_private(&in.priv, max);
+	select_fixed(&in.priv, &fixed_priv, sizeof(in.priv), fixed);
+}
+static void run_action(void) {
+	action(&in.pub, &base, &in.priv, num_batches, max, num_isogenies, my);
+}
+
+static void prepare_ctidh_action(bool fixed) {
+	ctidh_private(&in.priv);
+	select_fixed(&in.priv, &fixed_ctidh_priv, sizeof(in.priv), fixed);
+}
+static void run_ctidh_action(void) { ctidh_action(&in.pub, &base, &in.priv); }
+
+
+/* Welford's online mean and variance */
+typedef struct moments {
+	double n, mean, m2;
+} moments;
+
+static void moments_push(moments *m, double x) {
+	m->n += 1;
+	double d = x - m->mean;
+	m->mean += d / m->n;
+	m->m2 += d * (x - m->mean);
+}
+
+static double welch_t(moments const *a, moments const *b) {
+	if (a->n < 2 || b->n < 2)
+		return 0;
+	double va = a->m2 / (a->n - 1), vb = b->m2 / (b->n - 1);
+	double d = sqrt(va / a->n + vb / b->n);
+	return d ? (a->mean - b->mean) / d : 0;
+}
+
+static int cmp_double(void const *a, void const *b) {
+	double x = *(double const *) a, y = *(double const *) b;
+	return (x > y) - (x < y);
+}
+
+static double scale = 1;
+static double threshold = 10;
+static char const *filter = NULL;
+
+/* returns the largest |t| over all crops */
+static double test(target const *t) {
+	static double const crops[] = { 1.0, 0.99, 0.9, 0.75, 0.5 };
+	size_t const num_crops = sizeof(crops) / sizeof(*crops);
+	unsigned long n = t->measurements * scale;
+	double *times, *sorted, worst = 0;
+	uint8_t *cls;
+	ticks t0, t1;
+
+	if (n < 4)
+		n = 4;
+	times = calloc(n, sizeof(*times));
+	sorted = calloc(n, sizeof(*sorted));
+	cls = calloc(n, sizeof(*cls));
+	if (!times || !sorted || !cls)
+		exit(1);
+
+	randombytes(cls, n);
+	for (unsigned long i = 0; i < n; ++i)
+		cls[i] &= 1;
+
+	/* warm up */
+	for (unsigned long i = 0; i < n / 10 + 1; ++i) {
+		t->prepare(cls[i]);
+		t->run();
+	}
+
+	for (unsigned long i = 0; i < n; ++i) {
+		t->prepare(cls[i]);
+		t0 = getticks();
+		t->run();
+		t1 = getticks();
+		times[i] = elapsed(t1, t0);
+	}
+
+	memcpy(sorted, times, n * sizeof(*times));
+	qsort(sorted, n, sizeof(*sorted), cmp_double);
+
+	printf("%-16s %8lu", t->name, n);
+	for (size_t c = 0; c < num_crops; ++c) {
+		double cut = sorted[(size_t) ((n - 1) * crops[c])];
+		moments m[2] = {{0}};
+		for (unsigned long i = 0; i < n; ++i)
+			if (times[i] <= cut)
+				moments_push(&m[cls[i]], times[i]);
+		double tv = welch_t(&m[0], &m[1]);
+		printf(" %8.2lf", tv);
+		if (fabs(tv) > worst)
+			worst = fabs(tv);
+	}
+	printf("   %s\n", worst > threshold ? "FAIL" : "ok");
+	fflush(stdout);
+
+	free(times);
+	free(sorted);
+	free(cls);
+	return worst;
+}
+
+int main(int argc, char **argv) {
+	int opt;
+	bool failed = false;
+
+	while ((opt = getopt(argc, argv, "t:s:")) != -1) {
+		switch (opt) {
+		case 't': threshold = atof(optarg); break;
+		case 's': scale = atof(optarg); break;
+		default:
+			fprintf(stderr, "usage: %s [-t threshold] [-s scale] [filter]\n", argv[0]);
+			return 2;
+		}
+	}
+	if (optind < argc)
+		filter = argv[optind];
+
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(0, &set);
+	sched_setaffinity(0, sizeof(set), &set);
+
+	fp_random(&fixed_fp);
+	//a random fixed key: the zero key would never leave E_0 and skip elligator()
+	do
+		csidh_private(&fixed_priv, max);
+	while (!memcmp(&fixed_priv, &(private_key) {{ 0 }}, sizeof(fixed_priv)));
+	do
+		ctidh_private(&fixed_ctidh_priv);
+	while (!memcmp(&fixed_ctidh_priv, &(private_key) {{ 0 }}, sizeof(fixed_ctidh_priv)));
+	csidh_private(&in.priv, max);
+	action(&in.pub, &base, &in.priv, num_batches, max, num_isogenies, my);
+	curve_set(&E0, &(proj) { in.pub.A, fp_1 });
+
+	target const targets[] = {
+		{ "fp_mul3", 100000, prepare_fp, run_fp_mul3 },
+		{ "fp_sq2", 100000, prepare_fp, run_fp_sq2 },
+		{ "fp_mul4", 100000, prepare_fp, run_fp_mul4 },
+		{ "fp_mul8", 100000, prepare_fp, run_fp_mul8 },
+		{ "fp_inv", 10000, prepare_fp, run_fp_inv },
+		{ "fp_issquare", 10000, prepare_fp, run_fp_issquare },
+		{ "lookup", 100000, prepare_lookup, run_lookup },
+		{ "update", 100000, prepare_lookup, run_update },
+		{ "xMUL_ct", 1000, prepare_xmul, run_xMUL_ct },
+		{ "xMUL_ct_n", 1000, prepare_xmul, run_xMUL_ct_n },
+		{ "action", 200, prepare_action, run_action },
+		{ "ctidh_action", 200, prepare_ctidh_action, run_ctidh_action },
+	};
+
+	printf("%-16s %8s %8s %8s %8s %8s %8s   (|t| > %.1lf fails)\n", "t-statistic", "n",
+			"all", "99%", "90%", "75%", "50%", threshold);
+	for (size_t i = 0; i < sizeof(targets) / sizeof(*targets); ++i)
+		if (!filter || strstr(targets[i].name, filter))
+			failed |= test(&targets[i]) > threshold;
+
+	return failed;
+}
@@ -0,0 +1,381 @@
+#include <string.h>
+#include <assert.h>
+
+#include "ctidh.h"
+#include "rng.h"
+
+/* 1 iff x != 0, in constant time */
+static uint32_t fp_nonzero(fp const *x) {
+	uint64_t r = 0;
+	for (size_t i = 0; i < LIMBS; ++i)
+		r |= x->x.c[i];
+	return (r | -r) >> 63;
+}
+
+/* uniform e in Z^n with |e_1| + ... + |e_n| <= m, in constant time:
+ * stars and bars on n bars and m stars in random order, sorted by random
+ * keys with a sorting network, then random signs; negative zeros are
+ * rejected, which does not depend on the accepted key. */
+static void batch_private(int8_t *e, size_t n, size_t m) {
+	uint32_t r[n + m], bad;
+	uint8_t sign[n];
+
+	do {
+		randombytes(r, sizeof(r));
+		randombytes(sign, sizeof(sign));
+		for (size_t i = 0; i < n + m; ++i)
+			r[i] = (r[i] & ~1u) | (i < n); /* the low bit marks the bars */
+
+		/* odd-even transposition sort */
+		for (size_t i = 0; i < n + m; ++i) {
+			for (size_t j = i % 2; j + 1 < n + m; j += 2) {
+				uint32_t t = (r[j] ^ r[j + 1]) & -(uint32_t) (((uint64_t) r[j + 1] - r[j]) >> 63);
+				r[j] ^= t;
+				r[j + 1] ^= t;
+			}
+		}
+
+		/* e_j is the number of stars right before the j-th bar */
+		memset(e, 0, n);
+		uint32_t bars = 0;
+		for (size_t i = 0; i < n + m; ++i) {
+			uint32_t bar = r[i] & 1;
+			for (size_t j = 0; j < n; ++j)
+				e[j] += (1 ^ bar) & isequal(j, bars);
+			bars += bar;
+		}
+
+		bad = 0;
+		for (size_t j = 0; j < n; ++j) {
+			uint8_t neg = sign[j] & 1;
+			bad |= neg & isequal(e[j], 0);
+			e[j] = (e[j] ^ -neg) + neg;
+		}
+	} while (bad);
+}
+
+void ctidh_private(private_key *priv) {
+	for (size_t b = 0; b < ctidh_num_batches; ++b) {
+		size_t size = ctidh_batch_start[b + 1] - ctidh_batch_start[b];
+		int8_t e[size];
+		batch_private(e, size, ctidh_max[b]);
+		for (size_t i = 0; i < size; ++i)
+			priv->e[ctidh_batches[ctidh_batch_start[b] + i]] = e[i];
+	}
+}
+
+/* 2^32 (1 - 1/lmin) / (1 - 1/l): a kernel point of order l is found with
+ * probability 1 - 1/l, and is then used with this probability out of 2^32,
+ * so that every prime of a batch succeeds as often as the smallest one. */
+static uint64_t threshold(uint64_t lmin, uint64_t l) {
+	return ((lmin - 1) * l << 32) / (lmin * (l - 1));
+}
+
+/* the product of the primes in the batches todo[lower, upper) */
+static void batch_product(u512 *k, uint8_t const *todo, size_t lower, size_t upper) {
+	*k = u512_1;
+	for (size_t t = lower; t < upper; ++t)
+		for (size_t i = ctidh_batch_start[todo[t]]; i < ctidh_batch_start[todo[t] + 1]; ++i)
+			u512_mul3_64(k, k, primes[ctidh_batches[i]]);
+}
+
+/* the number of bits of k */
+static unsigned long bitlength(u512 const *k) {
+	unsigned long i = 64 * LIMBS;
+	while (i && !u512_bit(k, i - 1))
+		--i;
+	return i;
+}
+
+/* the secret choices for the next isogeny of a batch */
+typedef struct ctidh_choice {
+	size_t b;
+	size_t pos;         /* the prime within the batch */
+	int8_t ec;          /* its exponent */
+	uint8_t bc, s;      /* dummy isogeny, negative exponent */
+	uint64_t lsec, thr; /* the prime and its threshold() */
+} ctidh_choice;
+
+/* chooses the first prime of batch b with a non-zero exponent, a dummy
+ * isogeny of the smallest one if there is none, and multiplies k by the
+ * other primes of the batch, all in constant time. returns a public bound
+ * on the bits of k, whatever the choice. */
+static unsigned long ctidh_choose(ctidh_round const *r, size_t b, ctidh_choice *c, u512 *k) {
+	uint8_t const *batch = &ctidh_batches[ctidh_batch_start[b]];
+	size_t size = ctidh_batch_start[b + 1] - ctidh_batch_start[b];
+	uint64_t lmin = primes[batch[0]];
+	int8_t const *e = r->e;
+	u512 bound = *k;
+
+	uint32_t found = 0;
+	c->b = b;
+	c->pos = 0;
+	c->ec = 0;
+	for (size_t i = 0; i < size; ++i) {
+		uint32_t take = (1 ^ isequal(e[batch[i]], 0)) & (1 ^ found);
+		c->pos ^= (c->pos ^ i) & -(size_t) take;
+		cmov(&c->ec, &e[batch[i]], take);
+		found |= take;
+	}
+	c->bc = 1 ^ found;
+	c->s = (uint8_t) c->ec >> 7;
+
+	c->lsec = c->thr = 0;
+	for (size_t i = 0; i < size; ++i) {
+		uint64_t l = primes[batch[i]];
+		uint64_t mask = -(uint64_t) isequal(i, c->pos);
+		u512_mul3_64(k, k, l ^ ((l ^ 1) & mask));
+		c->lsec ^= (c->lsec ^ l) & mask;
+		c->thr ^= (c->thr ^ threshold(lmin, l)) & mask;
+		if (i)  //the largest cofactor leaves out the smallest prime
+			u512_mul3_64(&bound, &bound, l);
+	}
+	return bitlength(&bound);
+}
+
+/* the isogeny chosen by c with kernel point K, or a dummy one; K has the
+ * order of the chosen prime or is zero. */
+static void ctidh_isogeny(ctidh_round *r, proj const *K, ctidh_choice const *c) {
+	uint8_t const *batch = &ctidh_batches[ctidh_batch_start[c->b]];
+	size_t size = ctidh_batch_start[c->b + 1] - ctidh_batch_start[c->b];
+	uint64_t lmax = primes[batch[size - 1]];
+
+	uint32_t coin;
+	randombytes(&coin, sizeof(coin));
+
+	//succeeds with probability 1 - 1/lmin whatever the prime
+	if (!(fp_nonzero(&K->z) & (((uint64_t) coin - c->thr) >> 63)))  //depends only on randomness
+		return;
+
+	OPCOUNT_TIME(r->num_pending ? OPCOUNT_XISOG : OPCOUNT_LASTXISOG,
+			xISOG_matryoshka(&r->A, r->pending, r->num_pending, K, c->lsec, lmax, c->bc, r->work));
+
+	int8_t v = c->ec - (1 ^ c->bc) + (c->s << 1);
+	for (size_t i = 0; i < size; ++i)
+		cmov(&r->e[batch[i]], &v, isequal(i, c->pos));
+	--r->counter[c->b];
+}
+
+/* one or two batches todo[lower, upper); the orders of P[0] on the curve
+ * and P[1] on the twist only have their primes left. each batch picks its
+ * point by the sign of its exponent, and both kernel points come out of
+ * one two-lane ladder with secret scalars: the primes of the other batch
+ * times the other primes of its own. the second kernel point is pushed
+ * through the first isogeny. not inlined into ctidh_tree(), whose
+ * recursion would otherwise carry these locals on every level. */
+__attribute__((noinline)) static void ctidh_leaves(ctidh_round *r, proj const *P, size_t lower, size_t upper) {
+	size_t n = upper - lower;
+	ctidh_choice c[2];
+	curve E[2];
+	proj K[2], T;
+	u512 k[2];
+	unsigned long bits = 0;
+
+	assert(n == 1 || n == 2);
+
+	OPCOUNT_BEGIN(t_cofactor);
+	for (size_t j = 0; j < n; ++j) {
+		if (n == 2)
+			batch_product(&k[j], r->todo, upper - 1 - j, upper - j);
+		else
+			k[j] = u512_1;
+		unsigned long b = ctidh_choose(r, r->todo[lower + j], &c[j], &k[j]);
+		bits = b > bits ? b : bits;
+
+		//as in action(), positive exponents use the point on the twist
+		K[j] = P[0];
+		T = P[1];
+		fp_cswap(&K[j].x, &T.x, 1 ^ c[j].s);
+		fp_cswap(&K[j].z, &T.z, 1 ^ c[j].s);
+		E[j] = r->A;
+	}
+	xMUL_ct_n(K, E, K, k, bits, n);
+	OPCOUNT_PHASE(OPCOUNT_COFACTOR, t_cofactor);
+
+	if (n == 1) {
+		ctidh_isogeny(r, &K[0], &c[0]);
+	} else {
+		r->pending[r->num_pending++] = K[1];
+		ctidh_isogeny(r, &K[0], &c[0]);
+		K[1] = r->pending[--r->num_pending];
+		ctidh_isogeny(r, &K[1], &c[1]);
+	}
+
+	//the choices and kernel points depend on the exponents
+	zeroize(c, sizeof(c));
+	zeroize(K, sizeof(K));
+	zeroize(&T, sizeof(T));
+	zeroize(k, sizeof(k));
+	zeroize(E, sizeof(E));
+}
+
+/* a step of the two-point ladder costs about as much as pushing six
+ * points through a step of a Matryoshka walk (./bench on p512) */
+#define ladder_cost 6
+
+/* where ctidh_tree() splits todo[lower, upper), in r->split[lower][upper]:
+ * every batch is multiplied into the points of the other side at each
+ * split above it, and the two points of the right side are pushed through
+ * every isogeny of the left one. minimizes the sum by dynamic programming
+ * over the splits, with the costs of ctidh_leaves() at the bottom. */
+static void ctidh_strategy(ctidh_round *r, size_t num_todo) {
+	uint32_t bits[num_todo], cof[num_todo], walk[num_todo];
+	uint32_t cost[num_todo][num_todo + 1];
+
+	for (size_t t = 0; t < num_todo; ++t) {
+		size_t b = r->todo[t], lower = ctidh_batch_start[b], upper = ctidh_batch_start[b + 1];
+		u512 k;
+		batch_product(&k, r->todo, t, t + 1);
+		bits[t] = bitlength(&k);
+		k = u512_1;
+		for (size_t i = lower + 1; i < upper; ++i)
+			u512_mul3_64(&k, &k, primes[ctidh_batches[i]]);
+		cof[t] = bitlength(&k);
+		walk[t] = primes[ctidh_batches[upper - 1]] / 2;
+	}
+
+	for (size_t n = 1; n <= num_todo; ++n) {
+		for (size_t lower = 0, upper = n; upper <= num_todo; ++lower, ++upper) {
+			uint32_t *c = &cost[lower][upper];
+			if (n == 1) {
+				*c = ladder_cost * cof[lower];
+				continue;
+			}
+			if (n == 2) {
+				uint32_t b0 = bits[lower + 1] + cof[lower], b1 = bits[lower] + cof[lower + 1];
+				*c = ladder_cost * (b0 > b1 ? b0 : b1) + walk[lower];
+				continue;
+			}
+			uint32_t mul = 0, push = 0;
+			for (size_t t = lower; t < upper; ++t)
+				mul += ladder_cost * bits[t];
+			*c = UINT32_MAX;
+			for (size_t mid = lower + 1; mid < upper; ++mid) {
+				push += 2 * walk[mid - 1];
+				uint32_t d = mul + push + cost[lower][mid] + cost[mid][upper];
+				if (d < *c) {
+					*c = d;
+					r->split[lower][upper] = mid;
+				}
+			}
+		}
+	}
+}
+
+/* the batches todo[lower, upper) of a round, divide and conquer: the
+ * kernel points come from splitting the batches instead of multiplying by
+ * all later batches, and the points for the right half are pushed
+ * through the isogenies of the left half. the points of the left half
+ * are in r->path[depth], not on the stack of the recursion. */
+static void ctidh_tree(ctidh_round *r, proj const *P, size_t depth, size_t lower, size_t upper) {
+	assert(lower < upper);
+
+	if (upper - lower <= 2) {
+		ctidh_leaves(r, P, lower, upper);
+		return;
+	}
+
+	assert(depth < ctidh_num_batches);
+	size_t mid = r->split[lower][upper];
+	proj *L = r->path[depth], *R = &r->pending[r->num_pending];
+	u512 k;
+
+	OPCOUNT_BEGIN(t_cofactor);
+	batch_product(&k, r->todo, mid, upper);
+	xMUL2(&L[0], &L[1], &r->A, &P[0], &P[1], &k);
+	batch_product(&k, r->todo, lower, mid);
+	xMUL2(&R[0], &R[1], &r->A, &P[0], &P[1], &k);
+	OPCOUNT_PHASE(OPCOUNT_COFACTOR, t_cofactor);
+
+	r->num_pending += 2;
+	ctidh_tree(r, L, depth + 1, lower, mid);
+	r->num_pending -= 2;
+
+	memcpy(L, R, 2 * sizeof(proj));
+	ctidh_tree(r, L, depth + 1, mid, upper);
+	zeroize(L, 2 * sizeof(proj));
+	zeroize(R, 2 * sizeof(proj));
+	zeroize(&k, sizeof(k));
+}
+
+/* constant-time. */
+static void ctidh_run(public_key *out, public_key const *in, private_key const *priv, ctidh_round *r) {
+
+	size_t num_todo;
+	proj P[2];
+	u512 k;
+
+	memcpy(r->e, priv->e, sizeof(r->e));
+	memcpy(r->counter, ctidh_max, sizeof(r->counter));
+	r->num_pending = 0;
+
+	curve_set(&r->A, &(proj) { in->A, fp_1 });
+
+	for (;;) {
+		/* the unfinished batches; the others are multiplied out */
+		num_todo = 0;
+		u512_set(&k, 4);
+		for (size_t b = 0; b < ctidh_num_batches; ++b) {
+			if (r->counter[b]) {  //depends only on randomness
+				r->todo[num_todo++] = b;
+				continue;
+			}
+			for (size_t i = ctidh_batch_start[b]; i < ctidh_batch_start[b + 1]; ++i)
+				u512_mul3_64(&k, &k, primes[ctidh_batches[i]]);
+		}
+		if (!num_todo)
+			break;
+
+		OPCOUNT_BEGIN(t_elligator);
+		if (memcmp(&r->A.A.x, &fp_0, sizeof(fp))) {  //A = (0 : C) is the only projective zero
+			elligator(&P[0], &P[1], &r->A.A);
+		} else {
+			fp_enc(&P[0].x, &p_order); // point of full order on E_a with a=0
+			fp_sub3(&P[1].x, &fp_0, &P[0].x);
+			P[0].z = fp_1;
+			P[1].z = fp_1;
+		}
+		OPCOUNT_PHASE(OPCOUNT_ELLIGATOR, t_elligator);
+
+		OPCOUNT_BEGIN(t_xmul);
+		xMUL2(&P[0], &P[1], &r->A, &P[0], &P[1], &k);
+		OPCOUNT_PHASE(OPCOUNT_XMUL, t_xmul);
+
+		ctidh_strategy(r, num_todo);
+		ctidh_tree(r, P, 0, 0, num_todo);
+	}
+
+	OPCOUNT_BEGIN(t_normalize);
+	fp_inv(&r->A.A.z);
+	fp_mul3(&out->A, &r->A.A.x, &r->A.A.z);
+	OPCOUNT_PHASE(OPCOUNT_NORMALIZE, t_normalize);
+
+	//the exponents and counters, but also the curves and points on the way
+	zeroize(r, sizeof(*r));
+	zeroize(P, sizeof(P));
+	zeroize(&k, sizeof(k));
+}
+
+void ctidh_action_with(public_key *out, public_key const *in, private_key const *priv, ctidh_scratch *scratch) {
+	ctidh_run(out, in, priv, &scratch->action);
+}
+
+void ctidh_action(public_key *out, public_key const *in, private_key const *priv) {
+	ctidh_round r;
+	ctidh_run(out, in, priv, &r);
+}
+
+/* includes public-key validation. */
+bool ctidh_with(public_key *out, public_key const *in, private_key const *priv, ctidh_scratch *scratch) {
+	if (!validate_with(in, &scratch->validate)) {
+		fp_random(&out->A);
+		return false;
+	}
+	ctidh_action_with(out, in, priv, scratch);
+	return true;
+}
+
+bool ctidh(public_key *out, public_key const *in, private_key const *priv) {
+	ctidh_scratch scratch;
+	return ctidh_with(out, in, priv, &scratch);
+}
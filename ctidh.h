@@ -0,0 +1,45 @@
+#ifndef CTIDH_H
+#define CTIDH_H
+
+#include "csidh.h"
+
+/* CTIDH: the primes are grouped into batches and a private key only fixes
+ * how many isogenies are done per batch; which primes of a batch they use
+ * stays secret, see xISOG_matryoshka(). the keys are private_key and
+ * public_key of csidh.h, ctidh_action() computes the same group action. */
+
+/* specific to p, defined in p512.c or the generated parameter files:
+ * batch b consists of primes[ctidh_batches[i]] for ctidh_batch_start[b] <= i
+ * < ctidh_batch_start[b + 1], in ascending order, and its exponents satisfy
+ * |e_1| + |e_2| + ... <= ctidh_max[b]. */
+extern const uint8_t ctidh_batches[num_primes];
+extern const uint8_t ctidh_batch_start[ctidh_num_batches + 1];
+extern const int8_t ctidh_max[ctidh_num_batches];
+
+/* the state of ctidh_action(): the exponents and counters it uses up, and
+ * the curve and points of the current round */
+typedef struct ctidh_round {
+    curve A;
+    int8_t e[num_primes];   /* secret, cleared on return */
+    int8_t counter[ctidh_num_batches];
+    uint8_t todo[ctidh_num_batches]; /* the unfinished batches */
+    proj pending[2 * ctidh_num_batches]; /* pushed through every isogeny */
+    proj path[ctidh_num_batches][2]; /* the left points of ctidh_tree() */
+    isog_point work[2 * ctidh_num_batches]; /* for the pending points */
+    size_t num_pending;
+    uint8_t split[ctidh_num_batches][ctidh_num_batches + 1]; /* see ctidh_strategy() */
+} ctidh_round;
+
+/* the scratch buffer of the *_with() variants, as csidh_scratch */
+typedef union ctidh_scratch {
+    validate_state validate;
+    ctidh_round action;
+} ctidh_scratch;
+
+void ctidh_private(private_key *priv);
+void ctidh_action(public_key *out, public_key const *in, private_key const *priv);
+bool ctidh(public_key *out, public_key const *in, private_key const *priv);
+void ctidh_action_with(public_key *out, public_key const *in, private_key const *priv, ctidh_scratch *scratch);
+bool ctidh_with(public_key *out, public_key const *in, private_key const *priv, ctidh_scratch *scratch);
+
+#endif
@@ -2,6 +2,7 @@
 #define FP_H
 
 #include "u512.h"
+#include "opcount.h"
 
 /* fp is in the Montgomery domain, so interpreting that
    as an integer should never make sense.
@@ -10,6 +11,7 @@ typedef struct fp {
     u512 x;
 } fp;
 
+extern const u512 fp_p; /* the modulus */
 extern const fp fp_0;
 extern const fp fp_1;
 
@@ -27,11 +29,38 @@ void fp_add3(fp *x, fp const *y, fp const *z);
 void fp_sub3(fp *x, fp const *y, fp const *z);
 void fp_mul3(fp *x, fp const *y, fp const *z);
 
+/* x[i] = y[i] z[i] for the n <= 4 products in the lanes of one vector, */
+/* see fp_mul4.c; n <= 2 uses fp_mul3. all inputs of one call are read */
+/* before any of its outputs is written, so outputs may alias any input */
+void fp_mul4(fp *const x[], fp const *const y[], fp const *const z[], size_t n);
+/* the same for n <= 8 in one 512-bit vector, with the same aliasing rule */
+/* for all n products, also where it falls back to two fp_mul4 calls */
+void fp_mul8(fp *const x[], fp const *const y[], fp const *const z[], size_t n);
+
 void fp_sq1(fp *x);
 void fp_sq2(fp *x, fp const *y);
 void fp_inv(fp *x);
 bool fp_issquare(fp const *x);
+void fp_pow(fp *x, u512 const *e); /* not constant time in e */
 
 void fp_random(fp *x);
 
+#ifdef OPCOUNT
+/* count calls; the parentheses around the name suppress the expansion */
+#define fp_add2(x, y) (OPCOUNT_INC(add), (fp_add2)(x, y))
+#define fp_sub2(x, y) (OPCOUNT_INC(add), (fp_sub2)(x, y))
+#define fp_mul2(x, y) (OPCOUNT_INC(mul), (fp_mul2)(x, y))
+#define fp_add3(x, y, z) (OPCOUNT_INC(add), (fp_add3)(x, y, z))
+#define fp_sub3(x, y, z) (OPCOUNT_INC(add), (fp_sub3)(x, y, z))
+#define fp_mul3(x, y, z) (OPCOUNT_INC(mul), (fp_mul3)(x, y, z))
+/* fp_mul4 and fp_mul8 as the kernel they end up in, by the number of lanes */
+#define OPCOUNT_MULN(n) ((n) > 4 ? ++opcount.mul8 : (n) > 2 ? ++opcount.mul4 : (opcount.mul += (n)))
+#define fp_mul4(x, y, z, n) (OPCOUNT_MULN(n), (fp_mul4)(x, y, z, n))
+#define fp_mul8(x, y, z, n) (OPCOUNT_MULN(n), (fp_mul8)(x, y, z, n))
+#define fp_sq1(x) (OPCOUNT_INC(sq), (fp_sq1)(x))
+#define fp_sq2(x, y) (OPCOUNT_INC(sq), (fp_sq2)(x, y))
+#define fp_inv(x) (OPCOUNT_INC(inv), (fp_inv)(x))
+#define fp_issquare(x) (OPCOUNT_INC(issquare), (fp_issquare)(x))
+#endif
+
 #endif
@@ -0,0 +1,160 @@
+
+/* operations are counted at the call sites, see fp.h */
+#undef OPCOUNT
+
+#include <string.h>
+
+#include "fp.h"
+#include "rng.h"
+
+/* portable C version of fp.S for any LIMBS; the constants of the
+ * parameter set come from the file written by genparams.py. */
+
+extern const u512 fp_r_squared;
+extern const u512 fp_p_minus_2;
+extern const u512 fp_p_minus_1_halves;
+extern const uint64_t fp_inv_min_p_mod_r;
+
+/* x = y if c else z, c in {0, 1} */
+static void u512_select(u512 *x, u512 const *y, u512 const *z, uint64_t c)
+{
+    uint64_t m = -c;
+    for (size_t i = 0; i < LIMBS; ++i)
+        x->c[i] = (y->c[i] & m) | (z->c[i] & ~m);
+}
+
+void fp_set(fp *x, uint64_t y)
+{
+    u512_set(&x->x, y);
+    fp_enc(x, &x->x);
+}
+
+void fp_cswap(fp *x, fp *y, bool c)
+{
+    uint64_t m = -(uint64_t) c;
+    for (size_t i = 0; i < LIMBS; ++i) {
+        uint64_t t = (x->x.c[i] ^ y->x.c[i]) & m;
+        x->x.c[i] ^= t;
+        y->x.c[i] ^= t;
+    }
+}
+
+void fp_add3(fp *x, fp const *y, fp const *z)
+{
+    u512 s, t;
+    u512_add3(&s, &y->x, &z->x); /* no carry since p < 2^(64 LIMBS - 1) */
+    bool b = u512_sub3(&t, &s, &fp_p);
+    u512_select(&x->x, &s, &t, b);
+}
+
+void fp_add2(fp *x, fp const *y)
+{
+    fp_add3(x, x, y);
+}
+
+void fp_sub3(fp *x, fp const *y, fp const *z)
+{
+    u512 s, t;
+    bool b = u512_sub3(&s, &y->x, &z->x);
+    u512_add3(&t, &s, &fp_p);
+    u512_select(&x->x, &t, &s, b);
+}
+
+void fp_sub2(fp *x, fp const *y)
+{
+    fp_sub3(x, x, y);
+}
+
+/* Montgomery multiplication, coarsely integrated operand scanning */
+void fp_mul3(fp *x, fp const *y, fp const *z)
+{
+    uint64_t t[LIMBS + 2] = { 0 };
+    u512 r;
+
+    for (size_t i = 0; i < LIMBS; ++i) {
+        unsigned __int128 c = 0;
+        for (size_t j = 0; j < LIMBS; ++j) {
+            c += (unsigned __int128) y->x.c[j] * z->x.c[i] + t[j];
+            t[j] = c;
+            c >>= 64;
+        }
+        c += t[LIMBS];
+        t[LIMBS] = c;
+        t[LIMBS + 1] = c >> 64;
+
+        uint64_t m = t[0] * fp_inv_min_p_mod_r;
+        c = ((unsigned __int128) m * fp_p.c[0] + t[0]) >> 64;
+        for (size_t j = 1; j < LIMBS; ++j) {
+            c += (unsigned __int128) m * fp_p.c[j] + t[j];
+            t[j - 1] = c;
+            c >>= 64;
+        }
+        c += t[LIMBS];
+        t[LIMBS - 1] = c;
+        t[LIMBS] = t[LIMBS + 1] + (uint64_t) (c >> 64);
+    }
+
+    /* t < 2p */
+    memcpy(r.c, t, sizeof(r.c));
+    bool b = u512_sub3(&x->x, &r, &fp_p);
+    u512_select(&x->x, &r, &x->x, b);
+}
+
+void fp_mul2(fp *x, fp const *y)
+{
+    fp_mul3(x, x, y);
+}
+
+void fp_sq2(fp *x, fp const *y)
+{
+    fp_mul3(x, y, y);
+}
+
+void fp_sq1(fp *x)
+{
+    fp_mul3(x, x, x);
+}
+
+void fp_enc(fp *x, u512 const *y)
+{
+    fp_mul3(x, (fp const *) y, (fp const *) &fp_r_squared);
+}
+
+void fp_dec(u512 *x, fp const *y)
+{
+    fp_mul3((fp *) x, y, (fp const *) &u512_1);
+}
+
+/* (obviously) not constant time in the exponent! */
+void fp_pow(fp *x, u512 const *e)
+{
+    fp y = *x;
+    *x = fp_1;
+    for (size_t k = 0; k < 64 * LIMBS; ++k) {
+        if (u512_bit(e, k))
+            fp_mul2(x, &y);
+        fp_sq1(&y);
+    }
+}
+
+void fp_inv(fp *x)
+{
+    fp_pow(x, &fp_p_minus_2);
+}
+
+bool fp_issquare(fp const *x)
+{
+    fp y = *x;
+    fp_pow(&y, &fp_p_minus_1_halves);
+    return !memcmp(&y, &fp_1, sizeof(fp));
+}
+
+/* not constant time (but this shouldn't leak anything of importance) */
+void fp_random(fp *x)
+{
+    u512 t;
+    do {
+        randombytes(&x->x, sizeof(x->x));
+        x->x.c[LIMBS - 1] &= ((uint64_t) 1 << (PBITS % 64)) - 1;
+    } while (!u512_sub3(&t, &x->x, &fp_p));
+}
@@ -0,0 +1,245 @@
+
+/* operations are counted at the call sites, see fp.h */
+#undef OPCOUNT
+
+#include <string.h>
+
+#include "fp.h"
+
+/* up to four independent Montgomery multiplications in the 64-bit lanes of
+ * one 256-bit vector with AVX-512 IFMA (vpmadd52luq/vpmadd52huq), or up to
+ * eight in one 512-bit vector for fp_mul8, for any
+ * LIMBS. the lanes work in radix 2^52: y is shifted up by SHIFT bits, so
+ * that the Montgomery radix 2^(52 N52) of the lanes becomes the 2^(64 LIMBS)
+ * of fp_mul3 and the results are bitwise the same. falls back to fp_mul3 on
+ * CPUs without IFMA; AVX2 alone has no 52-bit multiplier to build this on. */
+
+#define N52 ((64 * LIMBS + 52) / 52)    /* p 2^SHIFT < 2^(52 N52 - 1) */
+#define SHIFT (52 * N52 - 64 * LIMBS)
+#define M52 (((uint64_t) 1 << 52) - 1)
+
+#if defined(__x86_64__) && defined(__GNUC__)
+
+#include <immintrin.h>
+
+#define IFMA __attribute__((target("avx512ifma,avx512vl")))
+#define IFMA8 __attribute__((target("avx512ifma,avx512f")))
+
+static bool ifma;
+static uint64_t p52[N52], pinv52;   /* p and -p^-1 mod 2^52 */
+
+/* the bits [52 j - s, 52 j + 52 - s) of x for all j, i.e. x 2^s in radix 2^52 */
+static inline __attribute__((always_inline)) void to52(uint64_t r[N52], u512 const *x, unsigned s)
+{
+    for (int j = 0; j < N52; ++j) {
+        int lo = 52 * j - (int) s, w = lo / 64, b = lo % 64;
+        uint64_t v = 0;
+        if (lo < 0) {
+            v = x->c[0] << -lo;
+        } else {
+            if (w < LIMBS)
+                v = x->c[w] >> b;
+            if (b > 12 && w + 1 < LIMBS)
+                v |= x->c[w + 1] << (64 - b);
+        }
+        r[j] = v & M52;
+    }
+}
+
+/* for normalized r < 2^(64 LIMBS) */
+static inline __attribute__((always_inline)) void from52(u512 *x, uint64_t const r[N52])
+{
+    memset(x, 0, sizeof(*x));
+    for (int j = 0; j < N52; ++j) {
+        int w = 52 * j / 64, b = 52 * j % 64;
+        if (w < LIMBS)
+            x->c[w] |= r[j] << b;
+        if (b > 12 && w + 1 < LIMBS)
+            x->c[w + 1] |= r[j] >> (64 - b);
+    }
+}
+
+__attribute__((constructor))
+static void fp_mul4_init(void)
+{
+    __builtin_cpu_init();
+    ifma = __builtin_cpu_supports("avx512ifma") && __builtin_cpu_supports("avx512vl");
+
+    uint64_t inv = 1;   /* p^-1 mod 2^64 by Newton iteration */
+    for (int i = 0; i < 6; ++i)
+        inv *= 2 - fp_p.c[0] * inv;
+    pinv52 = -inv & M52;
+    to52(p52, &fp_p, 0);
+}
+
+IFMA static void mul4_ifma(fp *const x[], fp const *const y[], fp const *const z[], size_t n)
+{
+    uint64_t a[N52][4] __attribute__((aligned(32))) = {{ 0 }};
+    uint64_t b[N52][4] __attribute__((aligned(32))) = {{ 0 }};
+    uint64_t t[N52];
+
+    for (size_t l = 0; l < n; ++l) {
+        to52(t, &y[l]->x, SHIFT);
+        for (int j = 0; j < N52; ++j)
+            a[j][l] = t[j];
+        to52(t, &z[l]->x, 0);
+        for (int j = 0; j < N52; ++j)
+            b[j][l] = t[j];
+    }
+
+    __m256i const zero = _mm256_setzero_si256();
+    __m256i const mask = _mm256_set1_epi64x(M52);
+    __m256i const pinv = _mm256_set1_epi64x(pinv52);
+    __m256i acc[N52 + 1];
+
+    /* b and p are read from memory in the loop: kept in registers as well, */
+    /* they would spill along with acc and double the stack frame */
+    for (int j = 0; j < N52; ++j)
+        acc[j] = zero;
+    acc[N52] = zero;
+
+    /* operand scanning; the limbs stay below 4 N52 2^52, no carries until the end */
+    for (int i = 0; i < N52; ++i) {
+        __m256i ai = _mm256_load_si256((__m256i const *) a[i]);
+        for (int j = 0; j < N52; ++j) {
+            acc[j] = _mm256_madd52lo_epu64(acc[j], ai, _mm256_load_si256((__m256i const *) b[j]));
+            acc[j + 1] = _mm256_madd52hi_epu64(acc[j + 1], ai, _mm256_load_si256((__m256i const *) b[j]));
+        }
+        __m256i m = _mm256_madd52lo_epu64(zero, acc[0], pinv);
+        for (int j = 0; j < N52; ++j) {
+            acc[j] = _mm256_madd52lo_epu64(acc[j], m, _mm256_set1_epi64x(p52[j]));
+            acc[j + 1] = _mm256_madd52hi_epu64(acc[j + 1], m, _mm256_set1_epi64x(p52[j]));
+        }
+        acc[1] = _mm256_add_epi64(acc[1], _mm256_srli_epi64(acc[0], 52));
+        for (int j = 0; j < N52; ++j)
+            acc[j] = acc[j + 1];
+        acc[N52] = zero;
+    }
+
+    for (int j = 0; j + 1 < N52; ++j) {
+        acc[j + 1] = _mm256_add_epi64(acc[j + 1], _mm256_srli_epi64(acc[j], 52));
+        acc[j] = _mm256_and_si256(acc[j], mask);
+    }
+
+    /* acc < 2p, subtract p unless that borrows */
+    __m256i d[N52], c = zero;
+    for (int j = 0; j < N52; ++j) {
+        d[j] = _mm256_add_epi64(_mm256_sub_epi64(acc[j], _mm256_set1_epi64x(p52[j])), c);
+        c = _mm256_srai_epi64(d[j], 52);
+        d[j] = _mm256_and_si256(d[j], mask);
+    }
+    c = _mm256_srai_epi64(c, 63);
+    for (int j = 0; j < N52; ++j)
+        _mm256_store_si256((__m256i *) a[j], _mm256_blendv_epi8(d[j], acc[j], c));
+
+    for (size_t l = 0; l < n; ++l) {
+        for (int j = 0; j < N52; ++j)
+            t[j] = a[j][l];
+        from52(&x[l]->x, t);
+    }
+}
+
+/* the same in the eight lanes of a 512-bit vector: twice the products for
+ * about the same latency, the conversions are what grows */
+IFMA8 static void mul8_ifma(fp *const x[], fp const *const y[], fp const *const z[], size_t n)
+{
+    uint64_t a[N52][8] __attribute__((aligned(64))) = {{ 0 }};
+    uint64_t b[N52][8] __attribute__((aligned(64))) = {{ 0 }};
+    uint64_t t[N52];
+
+    for (size_t l = 0; l < n; ++l) {
+        to52(t, &y[l]->x, SHIFT);
+        for (int j = 0; j < N52; ++j)
+            a[j][l] = t[j];
+        to52(t, &z[l]->x, 0);
+        for (int j = 0; j < N52; ++j)
+            b[j][l] = t[j];
+    }
+
+    __m512i const zero = _mm512_setzero_si512();
+    __m512i const mask = _mm512_set1_epi64(M52);
+    __m512i const pinv = _mm512_set1_epi64(pinv52);
+    __m512i acc[N52 + 1];
+
+    for (int j = 0; j < N52; ++j)
+        acc[j] = zero;
+    acc[N52] = zero;
+
+    for (int i = 0; i < N52; ++i) {
+        __m512i ai = _mm512_load_si512((__m512i const *) a[i]);
+        for (int j = 0; j < N52; ++j) {
+            acc[j] = _mm512_madd52lo_epu64(acc[j], ai, _mm512_load_si512((__m512i const *) b[j]));
+            acc[j + 1] = _mm512_madd52hi_epu64(acc[j + 1], ai, _mm512_load_si512((__m512i const *) b[j]));
+        }
+        __m512i m = _mm512_madd52lo_epu64(zero, acc[0], pinv);
+        for (int j = 0; j < N52; ++j) {
+            acc[j] = _mm512_madd52lo_epu64(acc[j], m, _mm512_set1_epi64(p52[j]));
+            acc[j + 1] = _mm512_madd52hi_epu64(acc[j + 1], m, _mm512_set1_epi64(p52[j]));
+        }
+        acc[1] = _mm512_add_epi64(acc[1], _mm512_srli_epi64(acc[0], 52));
+        for (int j = 0; j < N52; ++j)
+            acc[j] = acc[j + 1];
+        acc[N52] = zero;
+    }
+
+    for (int j = 0; j + 1 < N52; ++j) {
+        acc[j + 1] = _mm512_add_epi64(acc[j + 1], _mm512_srli_epi64(acc[j], 52));
+        acc[j] = _mm512_and_si512(acc[j], mask);
+    }
+
+    __m512i d[N52], c = zero;
+    for (int j = 0; j < N52; ++j) {
+        d[j] = _mm512_add_epi64(_mm512_sub_epi64(acc[j], _mm512_set1_epi64(p52[j])), c);
+        c = _mm512_srai_epi64(d[j], 52);
+        d[j] = _mm512_and_si512(d[j], mask);
+    }
+    __mmask8 keep = _mm512_cmplt_epi64_mask(c, zero);
+    for (int j = 0; j < N52; ++j)
+        _mm512_store_si512((__m512i *) a[j], _mm512_mask_blend_epi64(keep, d[j], acc[j]));
+
+    for (size_t l = 0; l < n; ++l) {
+        for (int j = 0; j < N52; ++j)
+            t[j] = a[j][l];
+        from52(&x[l]->x, t);
+    }
+}
+
+#endif
+
+void fp_mul4(fp *const x[], fp const *const y[], fp const *const z[], size_t n)
+{
+#ifdef IFMA
+    if (ifma && n > 2) {  // two fp_mul3 are cheaper than the conversions
+        mul4_ifma(x, y, z, n);
+        return;
+    }
+#endif
+    fp r[4];
+    for (size_t l = 0; l < n; ++l)
+        fp_mul3(&r[l], y[l], z[l]);
+    for (size_t l = 0; l < n; ++l)
+        x[l]->x = r[l].x;
+}
+
+// two calls, but still all inputs before any output; not inlined, so
+// that the buffer is not on the stack of the vector path
+__attribute__((noinline)) static void mul8_split(fp *const x[], fp const *const y[], fp const *const z[], size_t n)
+{
+    fp r[8], *const rp[8] = { &r[0], &r[1], &r[2], &r[3], &r[4], &r[5], &r[6], &r[7] };
+    fp_mul4(rp, y, z, n < 4 ? n : 4);
+    if (n > 4)
+        fp_mul4(rp + 4, y + 4, z + 4, n - 4);
+    for (size_t l = 0; l < n; ++l)
+        x[l]->x = r[l].x;
+}
+
+void fp_mul8(fp *const x[], fp const *const y[], fp const *const z[], size_t n)
+{
+#ifdef IFMA
+    if (ifma && n > 4) {
+        mul8_ifma(x, y, z, n);
+        return;
+    }
+#endif
+    mul8_split(x, y, z, n);
+}
@@ -0,0 +1,233 @@
+#!/usr/bin/env python3
+"""Generates a basis of the relation lattice for a small parameter set.
+
+    python3 genbasis.py NAME NUM_PRIMES
+
+for the p of python3 genparams.py NAME NUM_PRIMES, writes NAME.basis in
+the format of lattice_load(): the primes in the order of primes[], then an
+LLL-reduced basis of the e with prod l_i^e_i = 1. The class group of
+Z[sqrt(-p)] is computed with reduced binary quadratic forms of
+discriminant -4p, l_i = (l, pi - 1) is the form (l, 2, (p + 1) / l); the
+group order and the discrete logarithms use baby-step giant-step, so this
+only works up to p of about 64 bits. For CSIDH-512 see CSI-FiSh.
+"""
+
+import sys
+from fractions import Fraction
+from math import isqrt, pi, prod
+
+from genparams import find_prime
+
+
+def xgcd(a, b):
+    """(d, u, v) with u a + v b = d = gcd(a, b)"""
+    u0, v0, u1, v1 = 1, 0, 0, 1
+    while b:
+        q = a // b
+        a, b = b, a - q * b
+        u0, u1 = u1, u0 - q * u1
+        v0, v1 = v1, v0 - q * v1
+    return a, u0, v0
+
+
+def reduce(f):
+    a, b, c = f
+    while True:
+        if not -a < b <= a:
+            r = (a - b) // (2 * a)
+            b, c = b + 2 * r * a, a * r * r + b * r + c
+        elif a > c:
+            a, b, c = c, -b, a
+        elif a == c and b < 0:
+            b = -b
+        else:
+            return a, b, c
+
+
+def compose(f, g):
+    """Cohen, A Course in Computational Algebraic Number Theory, 5.4.7"""
+    if f[0] > g[0]:
+        f, g = g, f
+    a1, b1, c1 = f
+    a2, b2, c2 = g
+    s = (b1 + b2) // 2
+    n = b2 - s
+    if a2 % a1 == 0:
+        y1, d = 0, a1
+    else:
+        d, u, _ = xgcd(a2, a1)
+        y1 = u
+    if s % d == 0:
+        y2, x2, d1 = -1, 0, d
+    else:
+        d1, x2, y2 = xgcd(s, d)
+        y2 = -y2
+    v1, v2 = a1 // d1, a2 // d1
+    r = (y1 * y2 * n - x2 * c2) % v1
+    b3 = b2 + 2 * v2 * r
+    c3 = (c2 * d1 + r * (b2 + v2 * r)) // v1
+    return reduce((v1 * v2, b3, c3))
+
+
+def inverse(f):
+    return reduce((f[0], -f[1], f[2]))
+
+
+def power(f, k, one):
+    if k < 0:
+        f, k = inverse(f), -k
+    r = one
+    while k:
+        if k & 1:
+            r = compose(r, f)
+        f = compose(f, f)
+        k >>= 1
+    return r
+
+
+def prod_forms(forms, e, one):
+    r = one
+    for f, k in zip(forms, e):
+        r = compose(r, power(f, k, one))
+    return r
+
+
+def class_number_estimate(p, bound=1 << 20):
+    """sqrt(4p) / pi L(1, chi) with the Euler product up to bound"""
+    sieve = bytearray([1]) * bound
+    sieve[:2] = b'\0\0'
+    for q in range(2, isqrt(bound) + 1):
+        if sieve[q]:
+            sieve[q * q::q] = bytearray(len(sieve[q * q::q]))
+    L = 1.
+    for q in range(3, bound, 2):
+        if sieve[q]:
+            chi = pow(-p % q, (q - 1) // 2, q)  # (-4p / q) = (-p / q)
+            L /= 1 - (1 if chi == 1 else -1 if chi == q - 1 else 0) / q
+    return 2 * isqrt(p) / pi * L
+
+
+def factor(n):
+    fs, q = [], 2
+    while q * q <= n:
+        while n % q == 0:
+            fs.append(q)
+            n //= q
+        q += 1
+    return fs + [n] * (n > 1)
+
+
+def order(g, lo, hi, one):
+    """the order of g, from a multiple of it in [lo, hi)"""
+    m = isqrt(hi - lo) + 1
+    baby, x = {}, one
+    for j in range(m):
+        baby.setdefault(x, j)
+        x = compose(x, g)
+    step = inverse(x)  # g^-m
+    y = power(g, -lo, one)
+    for t in range(m + 1):
+        if y in baby:
+            n = lo + t * m + baby[y]
+            break
+        y = compose(y, step)
+    else:
+        sys.exit('no multiple of the order in [%d, %d)' % (lo, hi))
+    for q in factor(n):
+        if power(g, n // q, one) == one:
+            n //= q
+    return n
+
+
+def dlog(g, n, f, one):
+    """x with g^x = f, g of order n"""
+    m = isqrt(n) + 1
+    baby, x = {}, one
+    for j in range(m):
+        baby.setdefault(x, j)
+        x = compose(x, g)
+    step, y = inverse(x), f
+    for t in range(m + 1):
+        if y in baby:
+            return (t * m + baby[y]) % n
+        y = compose(y, step)
+    return None
+
+
+def lll(b, delta=Fraction(99, 100)):
+    b = [row[:] for row in b]
+    n = len(b)
+
+    def gram_schmidt():
+        bs, mu = [], [[Fraction(0)] * n for _ in range(n)]
+        for i in range(n):
+            v = [Fraction(x) for x in b[i]]
+            for j in range(i):
+                mu[i][j] = sum(Fraction(x) * y for x, y in zip(b[i], bs[j])) / sum(y * y for y in bs[j])
+                v = [x - mu[i][j] * y for x, y in zip(v, bs[j])]
+            bs.append(v)
+        return bs, mu
+
+    bs, mu = gram_schmidt()
+    k = 1
+    while k < n:
+        for j in range(k - 1, -1, -1):
+            q = round(mu[k][j])
+            if q:
+                b[k] = [x - q * y for x, y in zip(b[k], b[j])]
+                bs, mu = gram_schmidt()
+        nk = sum(x * x for x in bs[k])
+        nk1 = sum(x * x for x in bs[k - 1])
+        if nk >= (delta - mu[k][k - 1] ** 2) * nk1:
+            k += 1
+        else:
+            b[k], b[k - 1] = b[k - 1], b[k]
+            bs, mu = gram_schmidt()
+            k = max(k - 1, 1)
+    return b
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    name, num_primes = sys.argv[1], int(sys.argv[2])
+
+    ls = find_prime(num_primes)
+    p = 4 * prod(ls) - 1
+    ls = ls[::-1]  # the order of primes[]
+    one = (1, 0, p)
+    forms = [reduce((l, 2, (p + 1) // l)) for l in ls]
+
+    h = class_number_estimate(p)
+    lo, hi = int(h * .98), int(h * 1.02) + 1
+    g = forms[-1]
+    n = order(g, lo, hi, one)
+    if n < hi - lo:
+        sys.exit('the order %d of l = %d is too small to be told apart' % (n, ls[-1]))
+    xs = [dlog(g, n, f, one) for f in forms]
+    if None in xs:
+        sys.exit('the l_i are not all powers of l = %d' % ls[-1])
+
+    # e with sum e_i x_i = 0 mod n; x_i = 1 for the last prime
+    basis = [[0] * num_primes for _ in range(num_primes)]
+    basis[0][-1] = n
+    for i in range(num_primes - 1):
+        basis[i + 1][i] = 1
+        basis[i + 1][-1] = -xs[i] % n
+    basis = lll(basis)
+    for row in basis:
+        assert sum(e * x for e, x in zip(row, xs)) % n == 0
+        assert prod_forms(forms, row, one) == one
+
+    cmd = 'python3 genbasis.py ' + ' '.join(sys.argv[1:])
+    width = max(len(str(x)) for row in basis for x in row + ls)
+    with open(name + '.basis', 'w') as f:
+        f.write('# generated by %s, do not edit\n' % cmd)
+        f.write('# relation lattice of the %d primes of %s, determinant %d\n' % (num_primes, name, n))
+        f.write(' '.join('%*d' % (width, l) for l in ls) + '\n\n')
+        for row in basis:
+            f.write(' '.join('%*d' % (width, x) for x in row) + '\n')
+
+
+if __name__ == '__main__':
+    main()
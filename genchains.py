@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+"""Generates addition chains for the exponentiation in xISOG.
+
+    python3 genchains.py BOUND
+
+writes chains.h and chains.c with a shortest addition chain for every
+odd prime below BOUND, as a register program: step (d, a, b) means
+r[d] = r[a] * r[b], the input is in r[0]. The search only considers
+star chains (every element is the previous one plus an earlier one),
+which are optimal for all n < 12509.
+"""
+
+import sys
+
+
+def odd_primes(bound):
+    return [n for n in range(3, bound, 2)
+            if all(n % q for q in range(3, int(n ** .5) + 1, 2))]
+
+
+def shortest_chain(n):
+    """as a list of (i, j): element k + 1 is element i plus element j"""
+    length = n.bit_length() - 1
+    while True:
+        chain, steps = [1], []
+
+        def search():
+            k = len(chain) - 1
+            if chain[-1] == n:
+                return True
+            if k == length or chain[-1] << (length - k) < n:
+                return False
+            tried = set()
+            for j in range(k, -1, -1):
+                v = chain[-1] + chain[j]
+                if v > n or v in tried:
+                    continue
+                tried.add(v)
+                chain.append(v)
+                steps.append((k, j))
+                if search():
+                    return True
+                chain.pop()
+                steps.pop()
+            return False
+
+        if search():
+            return steps
+        length += 1
+
+
+def allocate(steps):
+    """maps the chain elements to as few registers as possible"""
+    last_use = {}
+    for k, (i, j) in enumerate(steps):
+        last_use[i] = last_use[j] = k
+    last_use[len(steps)] = len(steps)  # the result
+
+    reg, free, prog = {0: 0}, [], []
+    used = 1
+    for k, (i, j) in enumerate(steps):
+        for v in {i, j}:
+            if last_use[v] == k:
+                free.append(reg[v])
+        if free:
+            free.sort()
+            reg[k + 1] = free.pop(0)
+        else:
+            reg[k + 1] = used
+            used += 1
+        prog.append((reg[k + 1], reg[i], reg[j]))
+    return prog, reg[len(steps)], used
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(__doc__)
+    bound = int(sys.argv[1])
+    cmd = 'python3 genchains.py ' + sys.argv[1]
+
+    chains = {}
+    for l in odd_primes(bound):
+        chains[l] = allocate(shortest_chain(l))
+    regs = max(used for _, _, used in chains.values())
+
+    with open('chains.h', 'w') as f:
+        f.write('/* generated by %s, do not edit */\n\n' % cmd)
+        f.write('#ifndef CHAINS_H\n#define CHAINS_H\n\n')
+        f.write('#include <stdint.h>\n\n')
+        f.write('/* shortest addition chains for the odd primes below addchain_bound;\n')
+        f.write(' * step (d, a, b) computes r[d] = r[a] * r[b], the input is r[0] */\n')
+        f.write('#define addchain_bound %d\n' % bound)
+        f.write('#define addchain_regs %d\n\n' % regs)
+        f.write('typedef struct addchain {\n')
+        f.write('    uint8_t len;\n')
+        f.write('    uint8_t result;\n')
+        f.write('    uint8_t const (*steps)[3];\n')
+        f.write('} addchain;\n\n')
+        f.write('/* indexed by l / 2, len is 0 unless l is an odd prime */\n')
+        f.write('extern const addchain addchains[addchain_bound / 2];\n\n')
+        f.write('#endif\n')
+
+    with open('chains.c', 'w') as f:
+        f.write('/* generated by %s, do not edit */\n\n' % cmd)
+        f.write('#include "chains.h"\n\n')
+        for l, (prog, _, _) in chains.items():
+            f.write('static const uint8_t chain_%d[][3] = {' % l)
+            f.write(', '.join('{%d, %d, %d}' % s for s in prog))
+            f.write('};\n')
+        f.write('\nconst addchain addchains[addchain_bound / 2] = {\n')
+        for l, (prog, result, _) in chains.items():
+            f.write('    [%d] = { %d, %d, chain_%d },\n' % (l // 2, len(prog), result, l))
+        f.write('};\n')
+
+
+if __name__ == '__main__':
+    main()
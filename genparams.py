@@ -0,0 +1,214 @@
+#!/usr/bin/env python3
+"""Generates a CSIDH parameter set for fp_generic.c / u512_generic.c.
+
+    python3 genparams.py NAME NUM_PRIMES [MAX_EXPONENT]
+
+takes the first NUM_PRIMES - 1 odd primes and searches the smallest prime
+l > those such that p = 4 * 3 * 5 * ... * l - 1 is prime, then writes
+NAME.h (limb count, sizes, defaults) and NAME.c (field constants, prime
+list, validation bound, a point of full order on E_0, exponent bounds,
+CTIDH batches).
+For example, python3 genparams.py p1024 130 gives CSIDH-1024.
+"""
+
+import random
+import sys
+from math import comb, isqrt, log2, prod
+
+
+def is_prime(n, rounds=40):
+    if n < 2:
+        return False
+    for q in (2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37):
+        if n % q == 0:
+            return n == q
+    d, s = n - 1, 0
+    while d % 2 == 0:
+        d, s = d // 2, s + 1
+    rnd = random.Random(n)
+    for _ in range(rounds):
+        x = pow(rnd.randrange(2, n - 1), d, n)
+        if x in (1, n - 1):
+            continue
+        for _ in range(s - 1):
+            x = x * x % n
+            if x == n - 1:
+                break
+        else:
+            return False
+    return True
+
+
+def odd_primes(n):
+    ps, c = [], 3
+    while len(ps) < n:
+        if all(c % q for q in ps if q * q <= c):
+            ps.append(c)
+        c += 2
+    return ps
+
+
+def find_prime(num_primes):
+    ls = odd_primes(num_primes - 1)
+    l = ls[-1] + 2
+    while not (is_prime(l) and is_prime(4 * prod(ls) * l - 1)):
+        l += 2
+    return ls + [l]
+
+
+def xmul(x, k, p):
+    """x-coordinate of [k](x, y) on y^2 = x^3 + x, or None for infinity."""
+    a24 = pow(2, p - 2, p)  # (A + 2) / 4 with A = 0
+    x1, z1, x2, z2 = 1, 0, x, 1
+    for bit in bin(k)[2:]:
+        if bit == '1':
+            x1, z1, x2, z2 = x2, z2, x1, z1
+        t0, t1 = (x1 + z1) ** 2 % p, (x1 - z1) ** 2 % p
+        u = (x1 - z1) * (x2 + z2) % p
+        v = (x1 + z1) * (x2 - z2) % p
+        x2, z2 = (u + v) ** 2 % p, x * (u - v) ** 2 % p
+        c = t0 - t1
+        x1, z1 = t0 * t1 % p, c * (t1 + a24 * c) % p
+        if bit == '1':
+            x1, z1, x2, z2 = x2, z2, x1, z1
+    return None if z1 == 0 else x1 * pow(z1, p - 2, p) % p
+
+
+def full_order_point(ls, p):
+    """x with x^3 + x square whose point has order divisible by every l."""
+    rnd = random.Random(p)
+    while True:
+        x = rnd.randrange(2, p)
+        if pow(x ** 3 + x, (p - 1) // 2, p) != 1:
+            continue
+        if all(xmul(x, (p + 1) // l, p) is not None for l in ls):
+            return x
+
+
+def base_points(ls, p, x, batches):
+    """the points of round 0 of action() on E_0, see csidh.h"""
+    m = 1 % batches
+    k = 4 * prod(l for i, l in enumerate(ls) if i % batches != m)
+    c = prod(ls[m + batches::batches])
+    return [xmul(y, f * k, p) for f in (1, c, ls[m]) for y in (x, p - x)]
+
+
+def ctidh_keys(n, m):
+    """number of e in Z^n with |e_1| + ... + |e_n| <= m"""
+    return sum(comb(n, k) * comb(m, k) * 2 ** k for k in range(min(n, m) + 1))
+
+
+def ctidh_batches(ls, bits=256):
+    """about 1.6 sqrt(n) batches of consecutive primes, and bounds for
+    2^bits keys; a bound is raised where it adds the most key bits per
+    cost of an isogeny, the largest prime of the batch plus an estimate
+    for the scalar multiplications."""
+    ls = sorted(ls)
+    n = len(ls)
+    num = round(1.6 * isqrt(100 * n) / 10)
+    sizes = [n // num + (i >= num - n % num) for i in range(num)]
+    batches = [ls[sum(sizes[:i]):sum(sizes[:i + 1])] for i in range(num)]
+    overhead = prod(ls).bit_length() // 2
+    m = [0] * num
+
+    def gain(j):
+        return log2(ctidh_keys(len(batches[j]), m[j] + 1) / ctidh_keys(len(batches[j]), m[j]))
+
+    while sum(log2(ctidh_keys(len(b), k)) for b, k in zip(batches, m)) < bits:
+        j = max(range(num), key=lambda j: gain(j) / (batches[j][-1] + overhead))
+        m[j] += 1
+    return batches, m
+
+
+def words(x, limbs):
+    return [(x >> (64 * i)) & (2 ** 64 - 1) for i in range(limbs)]
+
+
+def u512(x, limbs, indent='\t'):
+    ws = ['0x%016x' % w for w in words(x, limbs)]
+    lines = [', '.join(ws[i:i + 4]) for i in range(0, len(ws), 4)]
+    return '{ .c = {\n' + ',\n'.join(indent + l for l in lines) + ' } }'
+
+
+def main():
+    if len(sys.argv) not in (3, 4):
+        sys.exit(__doc__)
+    name, num_primes = sys.argv[1], int(sys.argv[2])
+    max_exponent = int(sys.argv[3]) if len(sys.argv) == 4 else 2
+
+    ls = find_prime(num_primes)
+    p = 4 * prod(ls) - 1
+    pbits = p.bit_length()
+    limbs = (pbits + 1 + 63) // 64  # one spare bit for the additions
+    r = 2 ** (64 * limbs)
+    ls = ls[::-1]  # large primes first, as in p512.c
+
+    # no more keys than the class group has, about sqrt(p) elements
+    batches, bounds = ctidh_batches(ls, min(256, pbits // 2))
+
+    cmd = 'python3 genparams.py ' + ' '.join(sys.argv[1:])
+    guard = name.upper() + '_H'
+
+    with open(name + '.h', 'w') as f:
+        f.write('/* generated by %s, do not edit */\n\n' % cmd)
+        f.write('#ifndef %s\n#define %s\n\n' % (guard, guard))
+        f.write('#define LIMBS %d\n' % limbs)
+        f.write('#define PBITS %d\n' % pbits)
+        f.write('#define num_primes %d\n\n' % num_primes)
+        f.write('#define default_num_batches 3\n')
+        f.write('#define default_my 8\n')
+        f.write('#define default_num_isogenies %d\n\n' % (num_primes * max_exponent))
+        f.write('#define ctidh_num_batches %d\n\n' % len(batches))
+        f.write('#endif\n')
+
+    with open(name + '.c', 'w') as f:
+        f.write('/* generated by %s, do not edit */\n\n' % cmd)
+        f.write('#include "ctidh.h"\n\n')
+        f.write('/* p = 4')
+        for i, l in enumerate(sorted(ls)):
+            f.write((' *\n *' if i % 16 == 15 else ' *') + ' %d' % l)
+        f.write(' - 1 */\n\n')
+
+        f.write('const unsigned primes[num_primes] = {')
+        for i, l in enumerate(ls):
+            f.write(('\n\t' if i % 16 == 0 else ' ') + '%d,' % l)
+        f.write('\n};\n\n')
+
+        f.write('const int8_t default_max[num_primes] = {')
+        for i in range(num_primes):
+            f.write(('\n\t' if i % 16 == 0 else ' ') + '%d,' % max_exponent)
+        f.write('\n};\n\n')
+
+        f.write('/* CTIDH batches, bounds for a key space of 2^%.2f */\n'
+                % sum(log2(ctidh_keys(len(b), k)) for b, k in zip(batches, bounds)))
+        f.write('const uint8_t ctidh_batches[num_primes] = {\n')
+        for b in batches:
+            f.write('\t%s, /* %s */\n' % (', '.join(str(ls.index(l)) for l in b), ' '.join(map(str, b))))
+        f.write('};\n')
+        start = [sum(len(b) for b in batches[:i]) for i in range(len(batches) + 1)]
+        f.write('const uint8_t ctidh_batch_start[ctidh_num_batches + 1] = {%s};\n' % ', '.join(map(str, start)))
+        f.write('const int8_t ctidh_max[ctidh_num_batches] = {%s};\n\n' % ', '.join(map(str, bounds)))
+
+        f.write('/* floor(4 sqrt(p)) */\n')
+        f.write('const u512 four_sqrt_p = %s;\n\n' % u512(isqrt(16 * p), limbs))
+        f.write('/* x-coordinate of a point of full order on E_0 */\n')
+        x = full_order_point(ls, p)
+        f.write('const u512 p_order = %s;\n\n' % u512(x, limbs))
+        f.write('/* round 0 of action() from E_0 with default_num_batches, see csidh.h */\n')
+        f.write('const u512 base_points[6] = {\n')
+        for y in base_points(ls, p, x, 3):
+            f.write('\t%s,\n' % u512(y, limbs, '\t\t'))
+        f.write('};\n\n')
+
+        f.write('/* field constants for fp_generic.c */\n')
+        f.write('const u512 fp_p = %s;\n' % u512(p, limbs))
+        f.write('const u512 fp_r_squared = %s;\n' % u512(r * r % p, limbs))
+        f.write('const u512 fp_p_minus_2 = %s;\n' % u512(p - 2, limbs))
+        f.write('const u512 fp_p_minus_1_halves = %s;\n' % u512((p - 1) // 2, limbs))
+        f.write('const uint64_t fp_inv_min_p_mod_r = 0x%016x;\n\n' % (-pow(p, -1, 2 ** 64) % 2 ** 64))
+        f.write('const fp fp_0 = { { .c = { 0 } } };\n')
+        f.write('const fp fp_1 = { %s }; /* 2^%d mod p */\n' % (u512(r % p, limbs), 64 * limbs))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,279 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "u512.h"
+#include "fp.h"
+#include "mont.h"
+#include "csidh.h"
+#include "ctidh.h"
+#include "rng.h"
+
+/* known-answer tests: every entry seeds the deterministic generator and
+ * records csidh_private, action and csidh outputs byte by byte, then the
+ * same for ctidh_private, ctidh_action and ctidh. checking
+ * also compares the vector lookup() and update() with the scalar ones,
+ * the vector products with fp_mul3() and validate_batch() with validate().
+ * usage: ./kat -g > kat.txt    generate
+ *        ./kat kat.txt         check, exit status 1 on mismatch */
+
+static uint8_t num_batches = default_num_batches;
+static uint8_t my = default_my;
+static unsigned int num_isogenies = default_num_isogenies;
+
+static int8_t const *max = default_max;
+
+#define num_entries 8
+#define num_fields 11
+
+static char const *names[num_fields] = {
+	"seed", "priv_a", "pub_a", "priv_b", "pub_b", "shared",
+	"ctidh_priv_a", "ctidh_pub_a", "ctidh_priv_b", "ctidh_pub_b", "ctidh_shared",
+};
+
+typedef struct entry {
+	char field[num_fields][2 * sizeof(private_key) + 1]; /* the longest field */
+} entry;
+
+static void hex(char *out, void const *x, size_t l) {
+	for (size_t i = 0; i < l; ++i)
+		sprintf(out + 2 * i, "%02hhx", ((uint8_t const *) x)[i]);
+}
+
+static bool compute(entry *t, unsigned count) {
+	uint8_t seed[32];
+	rng_det rng;
+	private_key priv_a, priv_b, ct_priv_a, ct_priv_b;
+	public_key pub_a, pub_b, shared_a, shared_b;
+	public_key ct_pub_a, ct_pub_b, ct_shared_a, ct_shared_b;
+	bool ok = true;
+
+	for (size_t i = 0; i < sizeof(seed); ++i)
+		seed[i] = count + i;
+	rng_det_init(&rng, seed);
+	randombytes_set(rng_det_randombytes, &rng);
+
+	//all private keys before any action, which draws a different amount
+	//of randomness with -DRADICAL
+	csidh_private(&priv_a, max);
+	csidh_private(&priv_b, max);
+	ctidh_private(&ct_priv_a);
+	ctidh_private(&ct_priv_b);
+	action(&pub_a, &base, &priv_a, num_batches, max, num_isogenies, my);
+	action(&pub_b, &base, &priv_b, num_batches, max, num_isogenies, my);
+	ok &= csidh(&shared_a, &pub_b, &priv_a, num_batches, max, num_isogenies, my);
+	ok &= csidh(&shared_b, &pub_a, &priv_b, num_batches, max, num_isogenies, my);
+	ok &= !memcmp(&shared_a, &shared_b, sizeof(public_key));
+
+	ctidh_action(&ct_pub_a, &base, &ct_priv_a);
+	ctidh_action(&ct_pub_b, &base, &ct_priv_b);
+	ok &= ctidh(&ct_shared_a, &ct_pub_b, &ct_priv_a);
+	ok &= ctidh(&ct_shared_b, &ct_pub_a, &ct_priv_b);
+	ok &= !memcmp(&ct_shared_a, &ct_shared_b, sizeof(public_key));
+
+	//the variable-time action has to agree. its elligator() draws from the
+	//deterministic stream too, so it stays after everything that is recorded
+	public_key check;
+	action_vartime(&check, &base, &priv_a);
+	ok &= !memcmp(&check, &pub_a, sizeof(public_key));
+	action_vartime(&check, &pub_b, &priv_a);
+	ok &= !memcmp(&check, &shared_a, sizeof(public_key));
+	action_vartime(&check, &base, &ct_priv_a);
+	ok &= !memcmp(&check, &ct_pub_a, sizeof(public_key));
+
+	randombytes_set(NULL, NULL);
+
+	hex(t->field[0], seed, sizeof(seed));
+	hex(t->field[1], &priv_a, sizeof(priv_a));
+	hex(t->field[2], &pub_a, sizeof(pub_a));
+	hex(t->field[3], &priv_b, sizeof(priv_b));
+	hex(t->field[4], &pub_b, sizeof(pub_b));
+	hex(t->field[5], &shared_a, sizeof(shared_a));
+	hex(t->field[6], &ct_priv_a, sizeof(ct_priv_a));
+	hex(t->field[7], &ct_pub_a, sizeof(ct_pub_a));
+	hex(t->field[8], &ct_priv_b, sizeof(ct_priv_b));
+	hex(t->field[9], &ct_pub_b, sizeof(ct_pub_b));
+	hex(t->field[10], &ct_shared_a, sizeof(ct_shared_a));
+	return ok;
+}
+
+static int generate(void) {
+	entry t;
+	printf("# CSIDH-512 known-answer tests, ./kat -g\n");
+	for (unsigned count = 0; count < num_entries; ++count) {
+		if (!compute(&t, count)) {
+			fprintf(stderr, "entry %u: key exchange failed\n", count);
+			return 1;
+		}
+		printf("\ncount = %u\n", count);
+		for (size_t i = 0; i < num_fields; ++i)
+			printf("%s = %s\n", names[i], t.field[i]);
+	}
+	return 0;
+}
+
+/* lookup() and update() as built, with SSE2 or AVX2, against the scalar
+ * versions at every position */
+static unsigned check_lookup(void) {
+	int8_t e[num_primes], a[num_primes], b[num_primes], v;
+	unsigned failed = 0;
+
+	for (int k = 0; k < 16; ++k) {
+		randombytes(e, sizeof(e));
+		for (size_t pos = 0; pos < num_primes; ++pos) {
+			randombytes(&v, sizeof(v));
+			memcpy(a, e, sizeof(e));
+			memcpy(b, e, sizeof(e));
+			update(pos, a, v);
+			update_scalar(pos, b, v);
+			if (lookup(pos, e) != lookup_scalar(pos, e) || memcmp(a, b, sizeof(a))) {
+				printf("lookup/update mismatch at position %zu\n", pos);
+				++failed;
+			}
+		}
+	}
+	return failed;
+}
+
+static bool same_point(proj const *P, proj const *Q) {
+	fp a, b;
+	fp_mul3(&a, &P->x, &Q->z);
+	fp_mul3(&b, &Q->x, &P->z);
+	return !memcmp(&a, &b, sizeof(fp));
+}
+
+/* fp_mul4() and fp_mul8() with outputs that alias their own and other
+ * lanes' inputs against fp_mul3(), and the ladders that rely on it:
+ * xDBLADD() in place and xMUL_n() with more products than one fp_mul8() */
+static unsigned check_mul(void) {
+	fp v[8], a[8], r[8];
+	fp *x[8];
+	fp const *y[8], *z[8];
+	unsigned failed = 0;
+
+	for (size_t n = 1; n <= 8; ++n) {
+		for (int wide = 0; wide < 2; ++wide) {
+			if (!wide && n > 4)
+				continue;
+			for (size_t l = 0; l < n; ++l) {
+				fp_random(&v[l]);
+				a[l] = v[l];
+				x[l] = &a[l];
+				y[l] = &a[(l + 1) % n];
+				z[l] = &a[l];
+			}
+			for (size_t l = 0; l < n; ++l)
+				fp_mul3(&r[l], &v[(l + 1) % n], &v[l]);
+			if (wide)
+				fp_mul8(x, y, z, n);
+			else
+				fp_mul4(x, y, z, n);
+			if (memcmp(a, r, n * sizeof(fp))) {
+				printf("fp_mul%d mismatch with %zu aliased lanes\n", wide ? 8 : 4, n);
+				++failed;
+			}
+		}
+	}
+
+	curve E[3];
+	proj P[3], Q[3], R, S, T, U, PQ;
+	u512 k;
+	for (size_t j = 0; j < 3; ++j) {
+		fp_random(&R.x);
+		fp_random(&R.z);
+		curve_set(&E[j], &R);
+		fp_random(&P[j].x);
+		fp_random(&P[j].z);
+	}
+	fp_random(&PQ.x);
+	fp_random(&PQ.z);
+	xDBLADD(&R, &S, &P[0], &P[1], &PQ, &E[0].A24);
+	T = P[0];
+	U = P[1];
+	xDBLADD(&T, &U, &T, &U, &PQ, &E[0].A24);
+	if (!same_point(&R, &T) || !same_point(&S, &U)) {
+		printf("xDBLADD mismatch in place\n");
+		++failed;
+	}
+
+	randombytes(&k, sizeof(k));
+	xMUL_n(Q, E, P, &k, 3);
+	for (size_t j = 0; j < 3; ++j) {
+		xMUL(&R, &E[j], &P[j], &k);
+		if (!same_point(&R, &Q[j])) {
+			printf("xMUL_n mismatch in lane %zu\n", j);
+			++failed;
+		}
+	}
+	return failed;
+}
+
+/* validate_batch() over more than one batch of lanes, with valid keys
+ * between random ones that are almost surely not supersingular, and
+ * validate() on each of them */
+static unsigned check_validate(void) {
+	public_key in[validate_lanes + 2];
+	bool ok[validate_lanes + 2];
+	unsigned failed = 0;
+
+	for (size_t i = 0; i < validate_lanes + 2; ++i) {
+		if (i % 2)
+			in[i] = base;
+		else
+			fp_random(&in[i].A);
+	}
+	validate_batch(in, ok, validate_lanes + 2);
+	for (size_t i = 0; i < validate_lanes + 2; ++i) {
+		if (ok[i] != i % 2 || validate(&in[i]) != i % 2) {
+			printf("validate mismatch for key %zu\n", i);
+			++failed;
+		}
+	}
+	return failed;
+}
+
+static int check(char const *path) {
+	FILE *f = fopen(path, "r");
+	char line[1024], name[32], value[512];
+	entry t;
+	unsigned count = 0, entries = 0, failed = check_lookup() + check_mul() + check_validate();
+
+	if (!f) {
+		perror(path);
+		return 1;
+	}
+
+	while (fgets(line, sizeof(line), f)) {
+		if (sscanf(line, "%31s = %511s", name, value) != 2)
+			continue;
+		if (!strcmp(name, "count")) {
+			count = atoi(value);
+			if (!compute(&t, count)) {
+				printf("entry %u: key exchange failed\n", count);
+				++failed;
+			}
+			++entries;
+			continue;
+		}
+		for (size_t i = 0; i < num_fields; ++i) {
+			if (!strcmp(name, names[i]) && strcmp(value, t.field[i])) {
+				printf("entry %u: %s mismatch\n  expected %s\n  got      %s\n",
+						count, name, value, t.field[i]);
+				++failed;
+			}
+		}
+	}
+	fclose(f);
+
+	printf("%u entries, %u mismatches\n", entries, failed);
+	return failed || !entries;
+}
+
+int main(int argc, char **argv) {
+	if (argc == 2 && !strcmp(argv[1], "-g"))
+		return generate();
+	if (argc == 2)
+		return check(argv[1]);
+	fprintf(stderr, "usage: %s -g | %s kat.txt\n", argv[0], argv[0]);
+	return 2;
+}
@@ -0,0 +1,211 @@
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "keypool.h"
+
+/* the ring buffer is a bounded multi-producer multi-consumer queue:
+ * every slot carries a sequence number telling whether it is free for
+ * the producer of round pos or filled for the consumer of round pos. */
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static size_t depth(keypool *pool)
+{
+    size_t tail = atomic_load(&pool->tail);
+    size_t head = atomic_load(&pool->head);
+    return tail - head <= pool->mask + 1 ? tail - head : 0;
+}
+
+static bool push(keypool *pool, keypool_entry const *entry)
+{
+    size_t pos = atomic_load_explicit(&pool->tail, memory_order_relaxed);
+    keypool_slot *slot;
+
+    for (;;) {
+        slot = &pool->slots[pos & pool->mask];
+        size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t) seq - (intptr_t) pos;
+        if (!diff) {
+            if (atomic_compare_exchange_weak_explicit(&pool->tail, &pos, pos + 1,
+                        memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+            return false; /* full */
+        else
+            pos = atomic_load_explicit(&pool->tail, memory_order_relaxed);
+    }
+
+    slot->entry = *entry;
+    atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+    return true;
+}
+
+static bool pop(keypool *pool, keypool_entry *entry)
+{
+    size_t pos = atomic_load_explicit(&pool->head, memory_order_relaxed);
+    keypool_slot *slot;
+
+    for (;;) {
+        slot = &pool->slots[pos & pool->mask];
+        size_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+        intptr_t diff = (intptr_t) seq - (intptr_t) (pos + 1);
+        if (!diff) {
+            if (atomic_compare_exchange_weak_explicit(&pool->head, &pos, pos + 1,
+                        memory_order_relaxed, memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+            return false; /* empty */
+        else
+            pos = atomic_load_explicit(&pool->head, memory_order_relaxed);
+    }
+
+    *entry = slot->entry;
+    zeroize(&slot->entry, sizeof(slot->entry));
+    atomic_store_explicit(&slot->seq, pos + pool->mask + 1, memory_order_release);
+    return true;
+}
+
+static void *refill(void *arg)
+{
+    keypool *pool = arg;
+    keypool_params const *params = &pool->params;
+    keypool_entry entry;
+
+    while (!atomic_load(&pool->stop)) {
+
+        if (depth(pool) >= params->high_watermark) {
+            pthread_mutex_lock(&pool->lock);
+            /* clear the flag before looking at the depth again,
+             * so a consumer draining the pool now still wakes us up. */
+            atomic_store(&pool->refill, false);
+            while (!atomic_load(&pool->stop) && !atomic_load(&pool->refill)
+                    && depth(pool) >= params->low_watermark)
+                pthread_cond_wait(&pool->cond, &pool->lock);
+            pthread_mutex_unlock(&pool->lock);
+            continue;
+        }
+
+        uint64_t t0 = now_ns();
+        if (params->generate) {
+            params->generate(&entry);
+        } else {
+            csidh_private(&entry.priv, pool->max_exponent);
+            action(&entry.pub, &base, &entry.priv, params->num_batches,
+                    pool->max_exponent, params->num_isogenies, params->my);
+        }
+        atomic_fetch_add(&pool->busy_ns, now_ns() - t0);
+
+        atomic_fetch_add(&pool->generated, 1);
+        if (!push(pool, &entry))
+            atomic_fetch_add(&pool->dropped, 1);
+    }
+
+    zeroize(&entry, sizeof(entry));
+    return NULL;
+}
+
+bool keypool_init(keypool *pool, keypool_params const *params)
+{
+    memset(pool, 0, sizeof(*pool));
+
+    if (!params->num_threads || params->low_watermark > params->high_watermark
+            || params->high_watermark > params->capacity)
+        return false;
+
+    size_t capacity = 1;
+    while (capacity < params->capacity)
+        capacity <<= 1;
+
+    pool->params = *params;
+    pool->params.capacity = capacity;
+    memcpy(pool->max_exponent, params->max_exponent, sizeof(pool->max_exponent));
+    pool->params.max_exponent = pool->max_exponent;
+    pool->mask = capacity - 1;
+
+    if (!(pool->slots = calloc(capacity, sizeof(*pool->slots))))
+        return false;
+    for (size_t i = 0; i < capacity; ++i)
+        atomic_init(&pool->slots[i].seq, i);
+
+    if (!(pool->threads = calloc(params->num_threads, sizeof(*pool->threads)))) {
+        free(pool->slots);
+        return false;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->cond, NULL);
+
+    for (size_t i = 0; i < params->num_threads; ++i) {
+        if (pthread_create(&pool->threads[i], NULL, refill, pool)) {
+            pool->params.num_threads = i;
+            keypool_destroy(pool);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void keypool_destroy(keypool *pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    atomic_store(&pool->stop, true);
+    pthread_cond_broadcast(&pool->cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (size_t i = 0; i < pool->params.num_threads; ++i)
+        pthread_join(pool->threads[i], NULL);
+
+    pthread_cond_destroy(&pool->cond);
+    pthread_mutex_destroy(&pool->lock);
+
+    zeroize(pool->slots, (pool->mask + 1) * sizeof(*pool->slots));
+    free(pool->slots);
+    free(pool->threads);
+    pool->slots = NULL;
+    pool->threads = NULL;
+}
+
+/* lock-free; returns false if the pool is empty. */
+/* the caller owns the entry and should hand it to keypool_release(). */
+bool keypool_take(keypool *pool, keypool_entry *out)
+{
+    bool ok = pop(pool, out);
+
+    atomic_fetch_add(ok ? &pool->taken : &pool->misses, 1);
+
+    /* only the first consumer to cross the low watermark touches the lock. */
+    if (depth(pool) < pool->params.low_watermark && !atomic_exchange(&pool->refill, true)) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->cond);
+        pthread_mutex_unlock(&pool->lock);
+    }
+
+    return ok;
+}
+
+void keypool_release(keypool_entry *entry)
+{
+    zeroize(entry, sizeof(*entry));
+}
+
+void keypool_stats_get(keypool *pool, keypool_stats *stats)
+{
+    uint64_t busy_ns = atomic_load(&pool->busy_ns);
+
+    stats->depth = depth(pool);
+    stats->generated = atomic_load(&pool->generated);
+    stats->taken = atomic_load(&pool->taken);
+    stats->misses = atomic_load(&pool->misses);
+    stats->dropped = atomic_load(&pool->dropped);
+    stats->refill_rate = busy_ns ? 1e9 * stats->generated * pool->params.num_threads / busy_ns : 0;
+}
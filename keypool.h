@@ -0,0 +1,74 @@
+#ifndef KEYPOOL_H
+#define KEYPOOL_H
+
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "csidh.h"
+
+/* pool of precomputed ephemeral key pairs, refilled by background threads. */
+/* keypool_take() is lock-free and never blocks on key generation. */
+
+typedef struct keypool_entry {
+    private_key priv;
+    public_key pub;
+} keypool_entry;
+
+typedef struct keypool_slot {
+    _Atomic size_t seq;
+    keypool_entry entry;
+} keypool_slot;
+
+typedef struct keypool_params {
+    size_t capacity;        /* rounded up to a power of two */
+    size_t low_watermark;   /* refill threads wake up below this depth */
+    size_t high_watermark;  /* refill threads go back to sleep at this depth */
+    size_t num_threads;
+
+    uint8_t num_batches;
+    int8_t const *max_exponent;
+    unsigned int num_isogenies;
+    uint8_t my;
+
+    /* NULL for csidh_private() and action() with the parameters above;
+     * anything else fills the pool with its own entries, for tests */
+    void (*generate)(keypool_entry *entry);
+} keypool_params;
+
+typedef struct keypool_stats {
+    size_t depth;
+    uint64_t generated;
+    uint64_t taken;
+    uint64_t misses;        /* keypool_take() found the pool empty */
+    uint64_t dropped;       /* generated while the pool was full */
+    double refill_rate;     /* keys per second with all refill threads busy */
+} keypool_stats;
+
+typedef struct keypool {
+    keypool_slot *slots;
+    size_t mask;
+    _Atomic size_t head;    /* next slot to take */
+    _Atomic size_t tail;    /* next slot to fill */
+
+    keypool_params params;
+    int8_t max_exponent[num_primes];
+
+    pthread_t *threads;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    _Atomic bool refill;
+    _Atomic bool stop;
+
+    _Atomic uint64_t generated, taken, misses, dropped;
+    _Atomic uint64_t busy_ns;
+} keypool;
+
+bool keypool_init(keypool *pool, keypool_params const *params);
+void keypool_destroy(keypool *pool);
+
+bool keypool_take(keypool *pool, keypool_entry *out);
+void keypool_release(keypool_entry *entry);
+
+void keypool_stats_get(keypool *pool, keypool_stats *stats);
+
+#endif
@@ -0,0 +1,160 @@
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "lattice.h"
+
+/* the next integer of the file, skipping whitespace and comments */
+static bool next(FILE *f, long long *x)
+{
+    int c;
+    while ((c = fgetc(f)) != EOF) {
+        if (c == '#') {
+            while ((c = fgetc(f)) != EOF && c != '\n');
+            continue;
+        }
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+            ungetc(c, f);
+            return fscanf(f, "%lld", x) == 1;
+        }
+    }
+    return false;
+}
+
+static double dot(double const *x, double const *y)
+{
+    double s = 0;
+    for (size_t i = 0; i < num_primes; ++i)
+        s += x[i] * y[i];
+    return s;
+}
+
+static int64_t norm1(int64_t const *e)
+{
+    int64_t s = 0;
+    for (size_t i = 0; i < num_primes; ++i)
+        s += e[i] < 0 ? -e[i] : e[i];
+    return s;
+}
+
+bool lattice_load(lattice *L, char const *path)
+{
+    FILE *f = fopen(path, "r");
+    size_t col[num_primes];
+    bool seen[num_primes] = { false };
+    long long x;
+    bool ok = true;
+
+    if (!f)
+        return false;
+
+    for (size_t j = 0; ok && j < num_primes; ++j) {
+        size_t i = 0;
+        ok = next(f, &x);
+        while (ok && i < num_primes && primes[i] != x)
+            ++i;
+        ok = ok && i < num_primes && !seen[i];
+        if (ok) {
+            col[j] = i;
+            seen[i] = true;
+        }
+    }
+    for (size_t r = 0; ok && r < num_primes; ++r) {
+        for (size_t j = 0; ok && j < num_primes; ++j) {
+            ok = next(f, &x) && x >= INT32_MIN && x <= INT32_MAX;
+            if (ok)
+                L->b[r][col[j]] = x;
+        }
+    }
+    ok = ok && !next(f, &x);  /* nothing left over */
+    fclose(f);
+    if (!ok)
+        return false;
+
+    /* rows of an integer lattice: |bs[i]|^2 is a quotient of two integer
+     * Gram determinants, far from 0 unless the rows are dependent */
+    for (size_t i = 0; i < num_primes; ++i) {
+        for (size_t j = 0; j < num_primes; ++j)
+            L->bs[i][j] = L->b[i][j];
+        for (size_t k = 0; k < i; ++k) {
+            double mu = dot(L->bs[i], L->bs[k]) * L->bs_inv[k];
+            for (size_t j = 0; j < num_primes; ++j)
+                L->bs[i][j] -= mu * L->bs[k][j];
+        }
+        double n = dot(L->bs[i], L->bs[i]);
+        if (n < .5)
+            return false;
+        L->bs_inv[i] = 1 / n;
+    }
+    return true;
+}
+
+bool lattice_verify(lattice const *L, size_t *row)
+{
+    private_key e;
+    public_key out;
+
+    for (size_t r = 0; r < num_primes; ++r) {
+        *row = r;
+        for (size_t i = 0; i < num_primes; ++i) {
+            if (L->b[r][i] < INT8_MIN || L->b[r][i] > INT8_MAX)
+                return false;
+            e.e[i] = L->b[r][i];
+        }
+        action_vartime(&out, &base, &e);
+        if (memcmp(&out, &base, sizeof(out)))
+            return false;
+    }
+    return true;
+}
+
+bool lattice_reduce(private_key *out, lattice const *L, int32_t const *e)
+{
+    int64_t t[num_primes];
+    double td[num_primes];
+
+    for (size_t i = 0; i < num_primes; ++i)
+        t[i] = e[i];
+
+    /* nearest plane: after step i, t is within 1/2 of bs[i] of the
+     * hyperplane through the lattice spanned by the first i rows */
+    for (size_t i = num_primes; i-- > 0; ) {
+        for (size_t j = 0; j < num_primes; ++j)
+            td[j] = t[j];
+        int64_t c = llround(dot(td, L->bs[i]) * L->bs_inv[i]);
+        if (c)
+            for (size_t j = 0; j < num_primes; ++j)
+                t[j] -= c * L->b[i][j];
+    }
+
+    /* Babai minimizes the Euclidean distance, isogenies go by the L1 norm */
+    int64_t n = norm1(t);
+    for (bool better = true; better; ) {
+        better = false;
+        for (size_t i = 0; i < num_primes; ++i) {
+            for (int s = -1; s <= 1; s += 2) {
+                int64_t m = n;
+                for (size_t j = 0; j < num_primes; ++j) {
+                    int64_t a = t[j] < 0 ? -t[j] : t[j];
+                    int64_t u = t[j] + s * L->b[i][j];
+                    m += (u < 0 ? -u : u) - a;
+                }
+                if (m < n) {
+                    for (size_t j = 0; j < num_primes; ++j)
+                        t[j] += s * L->b[i][j];
+                    n = m;
+                    better = true;
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < num_primes; ++i) {
+        if (t[i] < INT8_MIN || t[i] > INT8_MAX)
+            return false;
+        out->e[i] = t[i];
+    }
+    return true;
+}
@@ -0,0 +1,39 @@
+#ifndef LATTICE_H
+#define LATTICE_H
+
+#include <stdint.h>
+
+#include "csidh.h"
+
+/* the relation lattice of the class group: exponent vectors e with
+ * prod l_i^e_i = 1, i.e. action(E, e) = E. two vectors that differ by a
+ * relation act the same, so any vector can be replaced by a short one of
+ * its coset, which costs fewer isogenies. the basis is loaded from a text
+ * file, see lattice_load(). genbasis.py computes one for small parameter
+ * sets such as p62, and only p62.basis is shipped and checked. there is
+ * no basis for CSIDH-512 yet, so ./reduce cannot be used for it: that
+ * needs the class group structure computed for CSI-FiSh and is left for a
+ * follow-up. all of this is variable time and only for public vectors. */
+
+typedef struct lattice {
+    int32_t b[num_primes][num_primes];  /* rows are relations, columns in the order of primes[] */
+    double bs[num_primes][num_primes];  /* Gram-Schmidt orthogonalization of the rows */
+    double bs_inv[num_primes];          /* 1 / |bs[i]|^2 */
+} lattice;
+
+/* whitespace-separated integers, '#' starts a comment: first the num_primes
+ * primes in the order of the columns, then num_primes rows of a basis,
+ * ideally BKZ-reduced. false if the file is malformed, the primes are not
+ * those of primes[] or the rows are linearly dependent. */
+bool lattice_load(lattice *L, char const *path);
+
+/* true if every row acts trivially on E_0, with action_vartime(); sets
+ * *row to the first one that does not, or that does not fit a private_key */
+bool lattice_verify(lattice const *L, size_t *row);
+
+/* a short vector out of the coset e + L: Babai's nearest plane, then
+ * adding or subtracting basis rows as long as that shortens the L1 norm,
+ * the number of isogenies. false if an entry does not fit a private_key. */
+bool lattice_reduce(private_key *out, lattice const *L, int32_t const *e);
+
+#endif
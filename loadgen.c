@@ -0,0 +1,258 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/resource.h>
+
+#include "csidh.h"
+#include "wire.h"
+
+/* load generator for csidhd: -c connections, each on its own thread,
+ * send exchange requests back to back (closed loop) until -n requests
+ * are done in total or -d seconds have passed. the client public keys
+ * are -k keys generated up front and reused round-robin, so the load
+ * generator itself does no isogenies while measuring. reports the
+ * latency percentiles, the throughput, and the daemon's CPU time per
+ * exchange, taken from its counters before and after the run.
+ * usage: ./loadgen [-s socket] [-c connections] [-n requests | -d seconds]
+ *                  [-k keys] [-w warm-up requests] */
+
+static uint8_t num_batches = default_num_batches;
+static uint8_t my = default_my;
+static unsigned int num_isogenies = default_num_isogenies;
+
+static int8_t const *max = default_max;
+
+static char const *path = "csidhd.sock";
+static uint8_t (*requests)[wire_header_len + wire_key_len];
+static unsigned long num_keys = 4;
+
+static unsigned long limit = 1000;  /* requests, unless duration is set */
+static double duration;
+static double t_end;
+static _Atomic unsigned long next;
+static _Atomic unsigned long errors;
+
+typedef struct samples {
+	double *t;                      /* seconds per request */
+	unsigned long n, size;
+} samples;
+
+static double now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double cpu_time(void) {
+	struct rusage ru;
+	getrusage(RUSAGE_SELF, &ru);
+	return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+}
+
+static int dial(void) {
+	struct sockaddr_un addr = { .sun_family = AF_UNIX };
+	strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (fd < 0 || connect(fd, (struct sockaddr *) &addr, sizeof(addr))) {
+		perror(path);
+		exit(1);
+	}
+	return fd;
+}
+
+/* one request and its response; false on a broken connection */
+static bool exchange(int fd, unsigned long k, uint8_t *status) {
+	uint8_t buf[wire_header_len + wire_max_len], type;
+	uint16_t len;
+
+	if (!wire_send(fd, requests[k % num_keys], sizeof(*requests))
+			|| !wire_recv(fd, buf, wire_header_len))
+		return false;
+	wire_get_header(buf, &type, status, &len);
+	return type == WIRE_EXCHANGE && len <= wire_max_len
+		&& wire_recv(fd, buf + wire_header_len, len)
+		&& (*status != WIRE_OK || len == wire_key_len);
+}
+
+static bool stats(wire_stats *s) {
+	uint8_t buf[wire_header_len + wire_stats_len], type, status;
+	uint16_t len;
+	int fd = dial();
+
+	wire_put_header(buf, WIRE_STATS, 0, 0);
+	bool ok = wire_send(fd, buf, wire_header_len) && wire_recv(fd, buf, wire_header_len);
+	wire_get_header(buf, &type, &status, &len);
+	ok = ok && type == WIRE_STATS && status == WIRE_OK && len == wire_stats_len
+		&& wire_recv(fd, buf + wire_header_len, len);
+	if (ok)
+		wire_get_stats(s, buf + wire_header_len);
+	close(fd);
+	return ok;
+}
+
+static void *client(void *arg) {
+	samples *l = arg;
+	int fd = dial();
+	uint8_t status;
+
+	for (;;) {
+		unsigned long k = atomic_fetch_add(&next, 1);
+		if (duration ? now() >= t_end : k >= limit)
+			break;
+		if (l->n == l->size) {
+			l->size = 2 * l->size + 64;
+			if (!(l->t = realloc(l->t, l->size * sizeof(*l->t)))) {
+				fprintf(stderr, "out of memory\n");
+				exit(1);
+			}
+		}
+		double t0 = now();
+		if (!exchange(fd, k, &status)) {
+			fprintf(stderr, "connection lost\n");
+			exit(1);
+		}
+		l->t[l->n++] = now() - t0;
+		if (status != WIRE_OK)
+			atomic_fetch_add(&errors, 1);
+	}
+
+	close(fd);
+	return NULL;
+}
+
+static int cmp_double(void const *a, void const *b) {
+	double x = *(double const *) a, y = *(double const *) b;
+	return (x > y) - (x < y);
+}
+
+static double percentile(double const *sorted, unsigned long n, double q) {
+	unsigned long i = q * n;
+	return sorted[i < n ? i : n - 1];
+}
+
+int main(int argc, char **argv) {
+	unsigned long num_clients = 1, warmup = 0;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "s:c:n:d:k:w:")) != -1) {
+		switch (opt) {
+		case 's': path = optarg; break;
+		case 'c': num_clients = strtoul(optarg, NULL, 10); break;
+		case 'n': limit = strtoul(optarg, NULL, 10); break;
+		case 'd': duration = atof(optarg); break;
+		case 'k': num_keys = strtoul(optarg, NULL, 10); break;
+		case 'w': warmup = strtoul(optarg, NULL, 10); break;
+		default:
+			fprintf(stderr, "usage: %s [-s socket] [-c connections] [-n requests | -d seconds] "
+					"[-k keys] [-w warm-up requests]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (!num_clients || !num_keys || (!duration && !limit)) {
+		fprintf(stderr, "need connections, keys and requests > 0\n");
+		return 1;
+	}
+
+	if (!(requests = calloc(num_keys, sizeof(*requests)))) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	double t0 = now();
+	for (unsigned long i = 0; i < num_keys; ++i) {
+		private_key priv;
+		public_key pub;
+		csidh_private(&priv, max);
+		action(&pub, &base, &priv, num_batches, max, num_isogenies, my);
+		wire_put_header(requests[i], WIRE_EXCHANGE, 0, wire_key_len);
+		wire_put_key(requests[i] + wire_header_len, &pub);
+	}
+	printf("%lu client keys in %.0f ms\n", num_keys, (now() - t0) * 1e3);
+
+	if (warmup) {
+		int fd = dial();
+		uint8_t status;
+		for (unsigned long k = 0; k < warmup; ++k)
+			if (!exchange(fd, k, &status) || status != WIRE_OK) {
+				fprintf(stderr, "warm-up failed\n");
+				return 1;
+			}
+		close(fd);
+	}
+
+	wire_stats before, after;
+	if (!stats(&before)) {
+		fprintf(stderr, "no stats from %s\n", path);
+		return 1;
+	}
+
+	pthread_t threads[num_clients];
+	samples l[num_clients];
+	memset(l, 0, sizeof(l));
+	double c0 = cpu_time();
+	t0 = now();
+	t_end = t0 + duration;
+	for (unsigned long i = 0; i < num_clients; ++i)
+		if (pthread_create(&threads[i], NULL, client, &l[i])) {
+			fprintf(stderr, "cannot start client %lu\n", i);
+			return 1;
+		}
+	for (unsigned long i = 0; i < num_clients; ++i)
+		pthread_join(threads[i], NULL);
+	double wall = now() - t0, cpu = cpu_time() - c0;
+
+	if (!stats(&after)) {
+		fprintf(stderr, "no stats from %s\n", path);
+		return 1;
+	}
+
+	unsigned long n = 0;
+	for (unsigned long i = 0; i < num_clients; ++i)
+		n += l[i].n;
+	double *latency = malloc((n + 1) * sizeof(*latency));
+	if (!latency) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	n = 0;
+	for (unsigned long i = 0; i < num_clients; ++i) {
+		if (l[i].n)
+			memcpy(latency + n, l[i].t, l[i].n * sizeof(*latency));
+		n += l[i].n;
+		free(l[i].t);
+	}
+	if (!n) {
+		fprintf(stderr, "no requests done\n");
+		return 1;
+	}
+	qsort(latency, n, sizeof(*latency), cmp_double);
+	double sum = 0;
+	for (unsigned long i = 0; i < n; ++i)
+		sum += latency[i];
+
+	uint64_t done = after.exchanges - before.exchanges;
+	printf("%lu connections, %lu exchanges in %.2f s, %lu errors\n",
+			num_clients, n, wall, (unsigned long) atomic_load(&errors));
+	printf("  throughput    %10.1f exchanges/s\n", n / wall);
+	printf("  latency mean  %10.2f ms\n", sum / n * 1e3);
+	printf("  latency p50   %10.2f ms\n", percentile(latency, n, .50) * 1e3);
+	printf("  latency p99   %10.2f ms\n", percentile(latency, n, .99) * 1e3);
+	printf("  latency p999  %10.2f ms\n", percentile(latency, n, .999) * 1e3);
+	printf("  latency max   %10.2f ms\n", latency[n - 1] * 1e3);
+	if (done) {
+		printf("  daemon CPU    %10.2f ms/exchange, %.2f cores busy\n",
+				(after.cpu_ns - before.cpu_ns) / 1e6 / done, (after.cpu_ns - before.cpu_ns) / 1e9 / wall);
+		printf("  pool misses   %10.1f %%\n",
+				100. * (after.pool_misses - before.pool_misses) / done);
+	}
+	printf("  loadgen CPU   %10.3f ms/exchange\n", cpu / n * 1e3);
+
+	free(latency);
+	free(requests);
+	return 0;
+}
@@ -12,7 +12,7 @@
 #include "cycle.h"
 
 void u512_print(u512 const *x) {
-	for (size_t i = 63; i < 64; --i)
+	for (size_t i = sizeof(x->c) - 1; i < sizeof(x->c); --i)
 		printf("%02hhx", i[(unsigned char *) x->c]);
 }
 
@@ -24,20 +24,16 @@ void fp_print(fp const *x) {
 
 int main() {
 
-	uint8_t num_batches = 3;
-	uint8_t my = 8;
+	uint8_t num_batches = default_num_batches;
+	uint8_t my = default_my;
 	clock_t t0, t1;
 	
-	int8_t max[num_primes] = {2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
-					4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 5, 5, 5, 5, 5,
-					5, 5, 6, 6, 6, 6, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 8,
-					9, 9, 9, 10, 10, 10, 10, 9, 8, 8, 8, 7, 7, 7, 7, 7, 6, 5,
-					1, 2, 2};
+	int8_t const *max = default_max;
 
 	private_key priv_alice, priv_bob;
 	public_key pub_alice, pub_bob;
 	public_key shared_alice, shared_bob;
-	unsigned int num_isogenies = 404;
+	unsigned int num_isogenies = default_num_isogenies;
 
 
 	// calculate inverses for "elligatoring"
@@ -114,5 +110,14 @@ int main() {
     		else
         	printf("\x1b[32mequal :)\x1b[0m\n");
     		printf("\n");
+
+#ifdef OPCOUNT
+		unsigned long calls = 10;
+		opcount_reset();
+		for (unsigned long i = 0; i < calls; ++i)
+			action(&shared_alice, &pub_bob, &priv_alice, num_batches, max, num_isogenies, my);
+		printf("operation counts of action() over %lu calls:\n\n", calls);
+		opcount_print(stdout, calls);
+#endif
 	
 }
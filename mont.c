@@ -3,47 +3,88 @@
 
 #include "mont.h"
 #include "u512.h"
+#include "chains.h"
+
+void curve_set(curve *E, proj const *A)
+{
+    E->A = *A;
+    fp_add3(&E->A24.x, &A->z, &A->z);
+    fp_add3(&E->A24.z, &E->A24.x, &E->A24.x);
+    fp_sub3(&E->Aed.z, &A->x, &E->A24.x);
+    fp_add2(&E->A24.x, &A->x);
+    E->Aed.x = E->A24.x;
+}
+
+/* the curve after an isogeny is known through its Edwards coefficients (a : d); */
+/* then A24 = (a : a-d) and (A : C) = (2(a+d) : a-d). */
+static void curve_from_edwards(curve *E, proj const *Aed)
+{
+    E->Aed = *Aed;
+    E->A24.x = Aed->x;
+    fp_sub3(&E->A24.z, &Aed->x, &Aed->z);
+    fp_add3(&E->A.x, &Aed->x, &Aed->z);
+    fp_add2(&E->A.x, &E->A.x);
+    E->A.z = E->A24.z;
+}
+
+/* independent products, collected with PRODUCT and done up to eight at a */
+/* time in the vector lanes of fp_mul8 by MULTIPLY. fp_mul8 reads all inputs */
+/* of one call before it writes, but MULTIPLY splits more than eight */
+/* products into several calls: a product may overwrite its own inputs, */
+/* but must not read the output of another one of the same MULTIPLY */
+#define PRODUCTS(size) fp *px[size]; fp const *py[size], *pz[size]; size_t pm = 0
+#define PRODUCT(x, y, z) (px[pm] = (x), py[pm] = (y), pz[pm] = (z), ++pm)
+#define MULTIPLY() (mul_all(pm, px, py, pz), pm = 0)
+
+static void mul_all(size_t m, fp *const x[], fp const *const y[], fp const *const z[])
+{
+    for (size_t i = 0; i < m; i += 8)
+        fp_mul8(x + i, y + i, z + i, m - i < 8 ? m - i : 8);
+}
 
 void xDBLADD(proj *R, proj *S, proj const *P, proj const *Q, proj const *PQ, proj const *A24)
 {
-    fp tmp0, tmp1, tmp2;        //requires precomputation of A24=(A+2C:4C)
+    fp tmp0, tmp1, tmp2, tmp3, tmp4, tmp5;  //requires precomputation of A24=(A+2C:4C)
+    PRODUCTS(4);
+    OPCOUNT_INC(xdbladd);
 
     fp_add3(&tmp0, &P->x, &P->z);
     fp_sub3(&tmp1, &P->x, &P->z);
-    fp_sq2(&R->x, &tmp0);
     fp_sub3(&tmp2, &Q->x, &Q->z);
-    fp_add3(&S->x, &Q->x, &Q->z);
-    fp_mul2(&tmp0, &tmp2);
-    fp_sq2(&R->z, &tmp1);
-    fp_mul2(&tmp1, &S->x);
+    fp_add3(&tmp3, &Q->x, &Q->z);
+    PRODUCT(&R->x, &tmp0, &tmp0);
+    PRODUCT(&R->z, &tmp1, &tmp1);
+    PRODUCT(&tmp4, &tmp0, &tmp2);
+    PRODUCT(&tmp5, &tmp1, &tmp3);
+    MULTIPLY();
     fp_sub3(&tmp2, &R->x, &R->z);
-    fp_mul2(&R->z, &A24->z);
-    fp_mul2(&R->x, &R->z);
-    fp_mul3(&S->x, &A24->x, &tmp2);
-    fp_sub3(&S->z, &tmp0, &tmp1);
-    fp_add2(&R->z, &S->x);
-    fp_add3(&S->x, &tmp0, &tmp1);
-    fp_mul2(&R->z, &tmp2);
-    fp_sq1(&S->z);
-    fp_sq1(&S->x);
-    fp_mul2(&S->z, &PQ->x);
-    fp_mul2(&S->x, &PQ->z);
+    fp_sub3(&S->z, &tmp4, &tmp5);
+    fp_add3(&S->x, &tmp4, &tmp5);
+    PRODUCT(&tmp0, &R->z, &A24->z);
+    PRODUCT(&tmp3, &A24->x, &tmp2);
+    PRODUCT(&S->z, &S->z, &S->z);
+    PRODUCT(&S->x, &S->x, &S->x);
+    MULTIPLY();
+    fp_add3(&tmp1, &tmp0, &tmp3);
+    PRODUCT(&R->x, &R->x, &tmp0);
+    PRODUCT(&R->z, &tmp1, &tmp2);
+    PRODUCT(&S->z, &S->z, &PQ->x);
+    PRODUCT(&S->x, &S->x, &PQ->z);
+    MULTIPLY();
 }
 
-void xDBL(proj *Q, proj const *A, proj const *P)
+void xDBL(proj *Q, curve const *E, proj const *P)
 {
     fp a, b, c;
+    OPCOUNT_INC(xdbl);
     fp_add3(&a, &P->x, &P->z);
     fp_sq1(&a);
     fp_sub3(&b, &P->x, &P->z);
     fp_sq1(&b);
     fp_sub3(&c, &a, &b);
-    fp_add2(&b, &b); fp_add2(&b, &b); /* multiplication by 4 */
-    fp_mul2(&b, &A->z);
+    fp_mul2(&b, &E->A24.z);
     fp_mul3(&Q->x, &a, &b);
-    fp_add3(&a, &A->z, &A->z); /* multiplication by 2 */
-    fp_add2(&a, &A->x);
-    fp_mul2(&a, &c);
+    fp_mul3(&a, &E->A24.x, &c);
     fp_add2(&a, &b);
     fp_mul3(&Q->z, &a, &c);
 }
@@ -51,6 +92,7 @@ void xDBL(proj *Q, proj const *A, proj const *P)
 void xADD(proj *S, proj const *P, proj const *Q, proj const *PQ)
 {
     fp a, b, c, d;
+    OPCOUNT_INC(xadd);
     fp_add3(&a, &P->x, &P->z);
     fp_sub3(&b, &P->x, &P->z);
     fp_add3(&c, &Q->x, &Q->z);
@@ -69,20 +111,15 @@ void xADD(proj *S, proj const *P, proj const *Q, proj const *PQ)
 /* P must not be the unique point of order 2. */
 /* not constant-time! */
 /* factors are independent from the secret -> no constant-time ladder */
-void xMUL(proj *Q, proj const *A, proj const *P, u512 const *k)
+void xMUL(proj *Q, curve const *E, proj const *P, u512 const *k)
 {
     proj R = *P;
-    proj A24;
     const proj Pcopy = *P; /* in case Q = P */
 
     Q->x = fp_1;
     Q->z = fp_0;
 
-    fp_add3(&A24.x, &A->z, &A->z);    //precomputation of A24=(A+2C:4C)
-    fp_add3(&A24.z, &A24.x, &A24.x);
-    fp_add2(&A24.x, &A->x);
-
-    unsigned long i = 512;
+    unsigned long i = 64 * LIMBS;
     while (--i && !u512_bit(k, i));
 
     do {
@@ -93,7 +130,7 @@ void xMUL(proj *Q, proj const *A, proj const *P, u512 const *k)
         //fp_cswap(&Q->x, &R.x, bit);
         //fp_cswap(&Q->z, &R.z, bit);
 
-        xDBLADD(Q, &R, Q, &R, &Pcopy, &A24);
+        xDBLADD(Q, &R, Q, &R, &Pcopy, &E->A24);
 
         if (bit) { proj T = *Q; *Q = R; R = T; } /* not constant-time */
         //fp_cswap(&Q->x, &R.x, bit);
@@ -102,119 +139,308 @@ void xMUL(proj *Q, proj const *A, proj const *P, u512 const *k)
     } while (i--);
 }
 
-//simultaneous square-and-multiply, computes x^exp and y^exp 
+/* runs the statement for all n lanes before the next one */
+#define LANES(...) for (size_t j = 0; j < n; ++j) { __VA_ARGS__; }
+
+/* xDBLADD for n independent ladders, R = 2R and S = R + S in place with */
+/* S = w[j].R and the difference w[j].P; the products of all lanes go */
+/* through fp_mul8 together */
+static void xDBLADD_n(proj *R, ladder_lane *w, curve const *E, size_t n)
+{
+    PRODUCTS(4 * n);
+    LANES(OPCOUNT_INC(xdbladd));
+
+    LANES(fp_add3(&w[j].tmp[0], &R[j].x, &R[j].z));
+    LANES(fp_sub3(&w[j].tmp[1], &R[j].x, &R[j].z));
+    LANES(fp_sub3(&w[j].tmp[2], &w[j].R.x, &w[j].R.z));
+    LANES(fp_add3(&w[j].tmp[3], &w[j].R.x, &w[j].R.z));
+    LANES(PRODUCT(&R[j].x, &w[j].tmp[0], &w[j].tmp[0]));
+    LANES(PRODUCT(&R[j].z, &w[j].tmp[1], &w[j].tmp[1]));
+    LANES(PRODUCT(&w[j].tmp[4], &w[j].tmp[0], &w[j].tmp[2]));
+    LANES(PRODUCT(&w[j].tmp[5], &w[j].tmp[1], &w[j].tmp[3]));
+    MULTIPLY();
+    LANES(fp_sub3(&w[j].tmp[2], &R[j].x, &R[j].z));
+    LANES(fp_sub3(&w[j].R.z, &w[j].tmp[4], &w[j].tmp[5]));
+    LANES(fp_add3(&w[j].R.x, &w[j].tmp[4], &w[j].tmp[5]));
+    LANES(PRODUCT(&w[j].tmp[0], &R[j].z, &E[j].A24.z));
+    LANES(PRODUCT(&w[j].tmp[3], &E[j].A24.x, &w[j].tmp[2]));
+    LANES(PRODUCT(&w[j].R.z, &w[j].R.z, &w[j].R.z));
+    LANES(PRODUCT(&w[j].R.x, &w[j].R.x, &w[j].R.x));
+    MULTIPLY();
+    LANES(fp_add3(&w[j].tmp[1], &w[j].tmp[0], &w[j].tmp[3]));
+    LANES(PRODUCT(&R[j].x, &R[j].x, &w[j].tmp[0]));
+    LANES(PRODUCT(&R[j].z, &w[j].tmp[1], &w[j].tmp[2]));
+    LANES(PRODUCT(&w[j].R.z, &w[j].R.z, &w[j].P.x));
+    LANES(PRODUCT(&w[j].R.x, &w[j].R.x, &w[j].P.z));
+    MULTIPLY();
+}
+
+/* xDBLADD_n for curves set from (A : 1), so A24 = (A+2 : 4), and */
+/* differences with z = 1: 4 R.z and the product with w[j].P.z are free, */
+/* which leaves 4, 4 and 2 products per lane instead of 4, 4 and 4 */
+static void xDBLADD_n_affine(proj *R, ladder_lane *w, curve const *E, size_t n)
+{
+    PRODUCTS(4 * n);
+    LANES(OPCOUNT_INC(xdbladd));
+
+    LANES(fp_add3(&w[j].tmp[0], &R[j].x, &R[j].z));
+    LANES(fp_sub3(&w[j].tmp[1], &R[j].x, &R[j].z));
+    LANES(fp_sub3(&w[j].tmp[2], &w[j].R.x, &w[j].R.z));
+    LANES(fp_add3(&w[j].tmp[3], &w[j].R.x, &w[j].R.z));
+    LANES(PRODUCT(&R[j].x, &w[j].tmp[0], &w[j].tmp[0]));
+    LANES(PRODUCT(&R[j].z, &w[j].tmp[1], &w[j].tmp[1]));
+    LANES(PRODUCT(&w[j].tmp[4], &w[j].tmp[0], &w[j].tmp[2]));
+    LANES(PRODUCT(&w[j].tmp[5], &w[j].tmp[1], &w[j].tmp[3]));
+    MULTIPLY();
+    LANES(fp_sub3(&w[j].tmp[2], &R[j].x, &R[j].z));
+    LANES(fp_add3(&w[j].tmp[0], &R[j].z, &R[j].z));
+    LANES(fp_add2(&w[j].tmp[0], &w[j].tmp[0]));
+    LANES(fp_sub3(&w[j].R.z, &w[j].tmp[4], &w[j].tmp[5]));
+    LANES(fp_add3(&w[j].R.x, &w[j].tmp[4], &w[j].tmp[5]));
+    LANES(PRODUCT(&R[j].x, &R[j].x, &w[j].tmp[0]));
+    LANES(PRODUCT(&w[j].tmp[3], &E[j].A24.x, &w[j].tmp[2]));
+    LANES(PRODUCT(&w[j].R.z, &w[j].R.z, &w[j].R.z));
+    LANES(PRODUCT(&w[j].R.x, &w[j].R.x, &w[j].R.x));
+    MULTIPLY();
+    LANES(fp_add3(&w[j].tmp[1], &w[j].tmp[0], &w[j].tmp[3]));
+    LANES(PRODUCT(&R[j].z, &w[j].tmp[1], &w[j].tmp[2]));
+    LANES(PRODUCT(&w[j].R.z, &w[j].R.z, &w[j].P.x));
+    MULTIPLY();
+}
+
+/* xMUL_n with the temporaries in w[n]; affine for P[j].z = 1 on curves */
+/* set from (A : 1), as in validate() */
+void xMUL_n_with(proj *Q, curve const *E, proj const *P, u512 const *k, size_t n, bool affine, ladder_lane *w)
+{
+    LANES(w[j].R = P[j]; w[j].P = P[j]; Q[j].x = fp_1; Q[j].z = fp_0); /* in case Q = P */
+
+    unsigned long i = 64 * LIMBS;
+    while (--i && !u512_bit(k, i));
+
+    do {
+
+        bool bit = u512_bit(k, i);
+
+        if (bit) LANES(proj T = Q[j]; Q[j] = w[j].R; w[j].R = T);
+
+        if (affine)
+            xDBLADD_n_affine(Q, w, E, n);
+        else
+            xDBLADD_n(Q, w, E, n);
+
+        if (bit) LANES(proj T = Q[j]; Q[j] = w[j].R; w[j].R = T);
+
+    } while (i--);
+}
+
+/* xMUL for n points P[j] on n curves E[j] with the same scalar k, */
+/* the ladders run in lockstep. not constant-time, as xMUL. */
+void xMUL_n(proj *Q, curve const *E, proj const *P, u512 const *k, size_t n)
+{
+    ladder_lane w[n];
+    xMUL_n_with(Q, E, P, k, n, false, w);
+}
+
+/* xMUL of two points on the same curve with the same scalar, e.g. the */
+/* points on the curve and the twist in a round of action(); the two */
+/* ladders run interleaved in xMUL_n. not constant-time, as xMUL. */
+void xMUL2(proj *Q, proj *Qd, curve const *E, proj const *P, proj const *Pd, u512 const *k)
+{
+    curve const E2[2] = { *E, *E };
+    proj T[2] = { *P, *Pd };
+
+    xMUL_n(T, E2, T, k, 2);
+
+    *Q = T[0];
+    *Qd = T[1];
+}
+
+/* Montgomery ladder for secret scalars k < 2^bits. */
+/* P must not be the unique point of order 2. */
+/* constant-time: always runs bits steps, the two swaps around each
+ * xDBLADD are merged into a single swap by bit ^ previous bit. */
+void xMUL_ct(proj *Q, curve const *E, proj const *P, u512 const *k, unsigned long bits)
+{
+    proj R = *P;
+    const proj Pcopy = *P; /* in case Q = P */
+    bool prev = 0;
+
+    Q->x = fp_1;
+    Q->z = fp_0;
+
+    for (unsigned long i = bits; i--; ) {
+
+        bool bit = u512_bit(k, i);
+
+        fp_cswap(&Q->x, &R.x, bit ^ prev);
+        fp_cswap(&Q->z, &R.z, bit ^ prev);
+        prev = bit;
+
+        xDBLADD(Q, &R, Q, &R, &Pcopy, &E->A24);
+    }
+
+    fp_cswap(&Q->x, &R.x, prev);
+    fp_cswap(&Q->z, &R.z, prev);
+}
+
+/* xMUL_ct for n points P[j] on n curves E[j], each with its own secret */
+/* scalar k[j] < 2^bits; the ladders run in lockstep as in xMUL_n. */
+void xMUL_ct_n(proj *Q, curve const *E, proj const *P, u512 const *k, unsigned long bits, size_t n)
+{
+    ladder_lane w[n];
+    bool prev[n];
+
+    LANES(w[j].R = P[j]; w[j].P = P[j]; Q[j].x = fp_1; Q[j].z = fp_0; prev[j] = 0); /* in case Q = P */
+
+    for (unsigned long i = bits; i--; ) {
+
+        LANES(bool bit = u512_bit(&k[j], i);
+              fp_cswap(&Q[j].x, &w[j].R.x, bit ^ prev[j]);
+              fp_cswap(&Q[j].z, &w[j].R.z, bit ^ prev[j]);
+              prev[j] = bit);
+
+        xDBLADD_n(Q, w, E, n);
+    }
+
+    LANES(fp_cswap(&Q[j].x, &w[j].R.x, prev[j]); fp_cswap(&Q[j].z, &w[j].R.z, prev[j]));
+}
+
+//simultaneous exponentiation, computes x^exp and y^exp
+//along the shortest addition chain for exp from chains.c if there is one,
+//left-to-right square-and-multiply otherwise; exp is public
 void exp_by_squaring_(fp* x, fp* y, uint64_t exp)
 {
-	fp result1, result2;
-	fp_set(&result1, 1);
-	fp_set(&result2, 1);
-
-    while (exp)
-    {
-        if (exp & 1){
-          fp_mul2(&result1, x);
-          fp_mul2(&result2, y);
+    if (exp % 2 && exp < addchain_bound && addchains[exp / 2].len) {
+        addchain const *c = &addchains[exp / 2];
+        fp rx[addchain_regs], ry[addchain_regs];
+        rx[0] = *x;
+        ry[0] = *y;
+        for (size_t i = 0; i < c->len; ++i) {
+            uint8_t const *s = c->steps[i];
+            if (s[1] == s[2]) {
+                fp_sq2(&rx[s[0]], &rx[s[1]]);
+                fp_sq2(&ry[s[0]], &ry[s[1]]);
+            } else {
+                fp_mul3(&rx[s[0]], &rx[s[1]], &rx[s[2]]);
+                fp_mul3(&ry[s[0]], &ry[s[1]], &ry[s[2]]);
+            }
         }
-	
+        *x = rx[c->result];
+        *y = ry[c->result];
+        return;
+    }
+
+    assert (exp);
+    fp bx = *x, by = *y;
+    int i = 63;
+    while (!(exp >> i & 1))
+        --i;
+    while (i--) {
         fp_sq1(x);
         fp_sq1(y);
-        exp >>= 1;
+        if (exp >> i & 1) {
+            fp_mul2(x, &bx);
+            fp_mul2(y, &by);
+        }
     }
-
-    fp_set(x, 0);
-    fp_add2(x, &result1);
-    fp_set(y, 0);
-    fp_add2(y, &result2);
-
-
 }
 
 
 /* computes the isogeny or dummy isogeny with kernel point K of order k */
-/* returns the new curve coefficient A and the image of P for real isogenies*/
-/* returns the old curve coefficient A and [k]P for dummy isogenies */
-void xISOG(proj *A, proj *P, proj *Pd, proj *K, uint64_t k, int mask)
+/* and pushes the n >= 1 points through it, sharing the kernel multiples */
+/* returns the new curve coefficient A and the images of the points for real isogenies */
+/* returns the old curve coefficient A, [k]points[0] and the other points unchanged for dummy isogenies */
+/* the points are passed by reference, so that xISOG() works in place */
+static void isog_n(curve *E, proj *const points[], size_t n, proj *K, uint64_t k, int mask)
 {
     assert (k >= 3);
     assert (k % 2 == 1);
+    assert (n >= 1);
 
-    fp tmp0, tmp1, tmp2, tmp3, tmp4, Psum, Pdif, Pdsum, Pddif;
-    proj Q, Qd, Aed, prod;
-    proj Acopy = *A;
-    proj Pdcopy = *Pd;
+    fp tmp0, tmp1, tmp2, Rsum, Rdif, ad, bc, sum[n], dif[n], t[n][2];
+    proj Q[n], Aed = E->Aed, prod;
+    PRODUCTS(4 + 2 * n);
 
-    fp_add3(&Aed.z, &A->z, &A->z);  //compute twisted Edwards curve coefficients
-    fp_add3(&Aed.x, &A->x, &Aed.z);
-    fp_sub3(&Aed.z, &A->x, &Aed.z);
-   
-    fp_add3(&Psum, &P->x, &P->z);   //precomputations
-    fp_sub3(&Pdif, &P->x, &P->z);
-    fp_add3(&Pdsum, &Pd->x, &Pd->z);   //precomputations
-    fp_sub3(&Pddif, &Pd->x, &Pd->z);
+    for (size_t j = 0; j < n; ++j) {   //precomputations
+        fp_add3(&sum[j], &points[j]->x, &points[j]->z);
+        fp_sub3(&dif[j], &points[j]->x, &points[j]->z);
+    }
 
     fp_sub3(&prod.x, &K->x, &K->z);
     fp_add3(&prod.z, &K->x, &K->z);
-    
-    fp_mul3(&tmp1, &prod.x, &Psum);
-    fp_mul3(&tmp0, &prod.z, &Pdif);
-    fp_add3(&Q.x, &tmp0, &tmp1);
-    fp_sub3(&Q.z, &tmp0, &tmp1);
-    fp_mul3(&tmp1, &prod.x, &Pdsum);   // for P'
-    fp_mul3(&tmp0, &prod.z, &Pddif);
-    fp_add3(&Qd.x, &tmp0, &tmp1);
-    fp_sub3(&Qd.z, &tmp0, &tmp1);
 
-    // CONSTANT TIME :
-    proj *R = K;
-    proj *S = P;
+    for (size_t j = 0; j < n; ++j) {
+        PRODUCT(&t[j][0], &prod.x, &sum[j]);
+        PRODUCT(&t[j][1], &prod.z, &dif[j]);
+    }
+    MULTIPLY();
+    for (size_t j = 0; j < n; ++j) {
+        fp_add3(&Q[j].x, &t[j][1], &t[j][0]);
+        fp_sub3(&Q[j].z, &t[j][1], &t[j][0]);
+    }
 
     // CONSTANT TIME :
-    fp_cswap(&R->x, &S->x, mask);
-    fp_cswap(&R->z, &S->z, mask);
+    proj *R = K;  //K for real iso, points[0] for dum iso
+    fp_cswap(&R->x, &points[0]->x, mask);
+    fp_cswap(&R->z, &points[0]->z, mask);
+
+    proj M[3] = {*R};
+    xDBL(&M[1], E, R);
 
-    proj M[3] = {*R};  //K for real iso, P for dum iso
-    xDBL(&M[1], A, R);
+    // xADD(M[i+1], M[i], R, M[i-1]) is interleaved with the products of
+    // step i, as it shares tmp0 and tmp1 with them
+    fp_add3(&Rsum, &R->x, &R->z);
+    fp_sub3(&Rdif, &R->x, &R->z);
 
     for (uint64_t i = 1; i < k / 2; ++i) {
 
-        if (i >= 2)
-            xADD(&M[i % 3], &M[(i - 1) % 3], R, &M[(i - 2) % 3]);
-
-	fp_sub3(&tmp1, &M[i % 3].x, &M[i % 3].z);
-	fp_add3(&tmp0, &M[i % 3].x, &M[i % 3].z);
-	fp_mul2(&prod.x, &tmp1);
-	fp_mul2(&prod.z, &tmp0);
-	fp_mul3(&tmp3, &tmp1, &Psum);  // for P
-	fp_mul3(&tmp4, &tmp0, &Pdif);
-	fp_add3(&tmp2, &tmp3, &tmp4);
-	fp_mul2(&Q.x, &tmp2);
-	fp_sub3(&tmp2, &tmp3, &tmp4);
-	fp_mul2(&Q.z, &tmp2);
-	fp_mul3(&tmp3, &tmp1, &Pdsum);  // for P'
-	fp_mul3(&tmp4, &tmp0, &Pddif);
-	fp_add3(&tmp2, &tmp3, &tmp4);
-	fp_mul2(&Qd.x, &tmp2);
-	fp_sub3(&tmp2, &tmp3, &tmp4);
-	fp_mul2(&Qd.z, &tmp2);
+        proj const *Mi = &M[i % 3], *Mp = &M[(i - 1) % 3];
+        proj *Mn = &M[(i + 1) % 3];
+        OPCOUNT_INC(xadd);
+
+        fp_sub3(&tmp1, &Mi->x, &Mi->z);
+        fp_add3(&tmp0, &Mi->x, &Mi->z);
+        PRODUCT(&prod.x, &prod.x, &tmp1);
+        PRODUCT(&prod.z, &prod.z, &tmp0);
+        PRODUCT(&ad, &tmp0, &Rdif);
+        PRODUCT(&bc, &tmp1, &Rsum);
+        for (size_t j = 0; j < n; ++j) {
+            PRODUCT(&t[j][0], &tmp1, &sum[j]);
+            PRODUCT(&t[j][1], &tmp0, &dif[j]);
+        }
+        MULTIPLY();
+
+        fp_add3(&tmp0, &ad, &bc);
+        fp_sub3(&tmp1, &ad, &bc);
+        PRODUCT(&tmp0, &tmp0, &tmp0);
+        PRODUCT(&tmp1, &tmp1, &tmp1);
+        for (size_t j = 0; j < n; ++j) {
+            fp_add3(&tmp2, &t[j][0], &t[j][1]);
+            fp_sub3(&t[j][1], &t[j][0], &t[j][1]);
+            t[j][0] = tmp2;
+            PRODUCT(&Q[j].x, &Q[j].x, &t[j][0]);
+        }
+        MULTIPLY();
+
+        PRODUCT(&Mn->x, &Mp->z, &tmp0);
+        PRODUCT(&Mn->z, &Mp->x, &tmp1);
+        for (size_t j = 0; j < n; ++j)
+            PRODUCT(&Q[j].z, &Q[j].z, &t[j][1]);
+        MULTIPLY();
 
     }
 
-    if (k>3)
-	xADD(&M[((k-1) / 2) % 3], &M[(((k-1) / 2)-1) % 3], R, &M[(((k-1) / 2)-2) % 3]);
-    proj Pdummy = *R, Pcopy = *R;
+    proj Pdummy;
 
-    xADD(&Pdummy, &M[((k-1) / 2) % 3],  &M[(((k-1) / 2)-1) % 3], &Pcopy);
+    xADD(&Pdummy, &M[((k-1) / 2) % 3],  &M[(((k-1) / 2)-1) % 3], R);
 
     // point evaluation
-    fp_sq1(&Q.x);
-    fp_sq1(&Q.z);
-    fp_mul2(&P->x, &Q.x);
-    fp_mul2(&P->z, &Q.z);
-    fp_sq1(&Qd.x);
-    fp_sq1(&Qd.z);
-    fp_mul2(&Pd->x, &Qd.x);
-    fp_mul2(&Pd->z, &Qd.z);
-
+    for (size_t j = 0; j < n; ++j) {
+        fp_sq1(&Q[j].x);
+        fp_sq1(&Q[j].z);
+        fp_mul2(&Q[j].x, &points[j]->x);
+        fp_mul2(&Q[j].z, &points[j]->z);
+    }
 
     //compute Aed.x^k, Aed.z^k
     exp_by_squaring_(&Aed.x, &Aed.z, k);
@@ -231,54 +457,235 @@ void xISOG(proj *A, proj *P, proj *Pd, proj *K, uint64_t k, int mask)
     fp_mul2(&Aed.z, &prod.x);
     fp_mul2(&Aed.x, &prod.z);
 
-    //compute Montgomery params
-    fp_add3(&A->x, &Aed.x, &Aed.z);
-    fp_sub3(&A->z, &Aed.x, &Aed.z);
-    fp_add2(&A->x, &A->x);
+    // CONSTANT TIME : keep the old Edwards coefficients for dummy isogenies;
+    // E is recomputed from them either way instead of keeping a copy of E
+    fp_cswap(&Aed.x, &E->Aed.x, mask);
+    fp_cswap(&Aed.z, &E->Aed.z, mask);
+
+    //compute Montgomery params and A24
+    curve_from_edwards(E, &Aed);
+
+    // CONSTANT TIME : images for real isogenies;
+    // [k]points[0] and the unchanged other points for dummy isogenies
+    fp_cswap(&Q[0].x, &Pdummy.x, mask);
+    fp_cswap(&Q[0].z, &Pdummy.z, mask);
+    *points[0] = Q[0];
+    for (size_t j = 1; j < n; ++j) {
+        fp_cswap(&points[j]->x, &Q[j].x, !mask);
+        fp_cswap(&points[j]->z, &Q[j].z, !mask);
+    }
+}
 
-    // CONSTANT TIME : swap back
-    fp_cswap(&A->x, &Acopy.x, mask);
-    fp_cswap(&A->z, &Acopy.z, mask);
+void xISOG_n(curve *E, proj *points, size_t n, proj *K, uint64_t k, int mask)
+{
+    proj *p[n];
+    for (size_t j = 0; j < n; ++j)
+        p[j] = &points[j];
+    isog_n(E, p, n, K, k, mask);
+}
 
-    // CONSTANT TIME :
-    fp_cswap(&P->x, &Pdummy.x, mask);
-    fp_cswap(&P->z, &Pdummy.z, mask);
-    fp_cswap(&Pd->x, &Pdcopy.x, mask);
-    fp_cswap(&Pd->z, &Pdcopy.z, mask);
+/* xISOG_n for the two points P and Pd of action(), in place */
+void xISOG(curve *E, proj *P, proj *Pd, proj *K, uint64_t k, int mask)
+{
+    isog_n(E, (proj *const []) { P, Pd }, 2, K, k, mask);
+}
 
+//constant-time exponentiation, computes x^exp and y^exp for a secret exp < 2^bits
+static void exp_ct(fp *x, fp *y, uint64_t exp, unsigned bits)
+{
+    fp bx = *x, by = *y, tx, ty;
+    *x = fp_1;
+    *y = fp_1;
+    for (unsigned i = bits; i--; ) {
+        fp_sq1(x);
+        fp_sq1(y);
+        fp_mul3(&tx, x, &bx);
+        fp_mul3(&ty, y, &by);
+        fp_cswap(x, &tx, exp >> i & 1);
+        fp_cswap(y, &ty, exp >> i & 1);
+    }
+}
+
+/* Matryoshka isogeny: xISOG_n for a secret odd degree 3 <= k <= kmax. */
+/* always walks the kernel multiples up to (kmax-1)/2 and only multiplies */
+/* the ones up to (k-1)/2 in, so the time depends on kmax only. */
+/* n = 0 points is allowed. dummy isogenies keep the curve and the points. */
+/* w holds the temporaries of the n points, so that the caller decides */
+/* where they live. */
+void xISOG_matryoshka(curve *E, proj *points, size_t n, proj const *K, uint64_t k, uint64_t kmax, int mask,
+        isog_point *w)
+{
+    assert (kmax >= 3);
+    assert (kmax % 2 == 1);
+
+    fp tmp0, tmp1, tmp2, Ksum, Kdif, ad, bc;
+    proj Aed = E->Aed, prod, prodn;
+    PRODUCTS(4 + 2 * n);
+
+    for (size_t j = 0; j < n; ++j) {
+        fp_add3(&w[j].sum, &points[j].x, &points[j].z);
+        fp_sub3(&w[j].dif, &points[j].x, &points[j].z);
+    }
+
+    fp_sub3(&prod.x, &K->x, &K->z);
+    fp_add3(&prod.z, &K->x, &K->z);
+
+    for (size_t j = 0; j < n; ++j) {
+        PRODUCT(&w[j].t[0], &prod.x, &w[j].sum);
+        PRODUCT(&w[j].t[1], &prod.z, &w[j].dif);
+    }
+    MULTIPLY();
+    for (size_t j = 0; j < n; ++j) {
+        fp_add3(&w[j].Q.x, &w[j].t[1], &w[j].t[0]);
+        fp_sub3(&w[j].Q.z, &w[j].t[1], &w[j].t[0]);
+    }
+
+    proj M[3] = {*K};
+    xDBL(&M[1], E, K);
+
+    // xADD(M[i+1], M[i], K, M[i-1]) interleaved as in xISOG_n
+    Ksum = prod.z;
+    Kdif = prod.x;
+
+    for (uint64_t i = 1; i < kmax / 2; ++i) {
+
+        bool active = (i - k / 2) >> 63; /* i < k/2 */
+        bool next = i + 1 < kmax / 2;
+        proj const *Mi = &M[i % 3], *Mp = &M[(i - 1) % 3];
+        proj *Mn = &M[(i + 1) % 3];
+
+        fp_sub3(&tmp1, &Mi->x, &Mi->z);
+        fp_add3(&tmp0, &Mi->x, &Mi->z);
+        PRODUCT(&prodn.x, &prod.x, &tmp1);
+        PRODUCT(&prodn.z, &prod.z, &tmp0);
+        if (next) {
+            OPCOUNT_INC(xadd);
+            PRODUCT(&ad, &tmp0, &Kdif);
+            PRODUCT(&bc, &tmp1, &Ksum);
+        }
+        for (size_t j = 0; j < n; ++j) {
+            PRODUCT(&w[j].t[0], &tmp1, &w[j].sum);
+            PRODUCT(&w[j].t[1], &tmp0, &w[j].dif);
+        }
+        MULTIPLY();
+
+        if (next) {
+            fp_add3(&tmp0, &ad, &bc);
+            fp_sub3(&tmp1, &ad, &bc);
+            PRODUCT(&tmp0, &tmp0, &tmp0);
+            PRODUCT(&tmp1, &tmp1, &tmp1);
+        }
+        for (size_t j = 0; j < n; ++j) {
+            fp_add3(&tmp2, &w[j].t[0], &w[j].t[1]);
+            fp_sub3(&w[j].t[1], &w[j].t[0], &w[j].t[1]);
+            w[j].t[0] = tmp2;
+            PRODUCT(&w[j].t[0], &w[j].Q.x, &w[j].t[0]);
+        }
+        MULTIPLY();
+
+        if (next) {
+            PRODUCT(&Mn->x, &Mp->z, &tmp0);
+            PRODUCT(&Mn->z, &Mp->x, &tmp1);
+        }
+        for (size_t j = 0; j < n; ++j)
+            PRODUCT(&w[j].t[1], &w[j].Q.z, &w[j].t[1]);
+        MULTIPLY();
+
+        // CONSTANT TIME : the steps past (k-1)/2 are computed and dropped
+        fp_cswap(&prod.x, &prodn.x, active);
+        fp_cswap(&prod.z, &prodn.z, active);
+        for (size_t j = 0; j < n; ++j) {
+            fp_cswap(&w[j].Q.x, &w[j].t[0], active);
+            fp_cswap(&w[j].Q.z, &w[j].t[1], active);
+        }
+
+    }
+
+    // point evaluation
+    for (size_t j = 0; j < n; ++j) {
+        fp_sq1(&w[j].Q.x);
+        fp_sq1(&w[j].Q.z);
+        fp_mul2(&w[j].Q.x, &points[j].x);
+        fp_mul2(&w[j].Q.z, &points[j].z);
+    }
+
+    //compute Aed.x^k, Aed.z^k
+    unsigned bits = 0;
+    while (kmax >> bits)
+        ++bits;
+    exp_ct(&Aed.x, &Aed.z, k, bits);
+
+    //compute prod.x^8, prod.z^8
+    fp_sq1(&prod.x);
+    fp_sq1(&prod.x);
+    fp_sq1(&prod.x);
+    fp_sq1(&prod.z);
+    fp_sq1(&prod.z);
+    fp_sq1(&prod.z);
+
+    //compute image curve parameters
+    fp_mul2(&Aed.z, &prod.x);
+    fp_mul2(&Aed.x, &prod.z);
+
+    // CONSTANT TIME : keep the old curve and points for dummy isogenies
+    fp_cswap(&Aed.x, &E->Aed.x, mask);
+    fp_cswap(&Aed.z, &E->Aed.z, mask);
+    curve_from_edwards(E, &Aed);
+
+    for (size_t j = 0; j < n; ++j) {
+        fp_cswap(&points[j].x, &w[j].Q.x, !mask);
+        fp_cswap(&points[j].z, &w[j].Q.z, !mask);
+    }
 }
 
 /* computes the last real/dummy isogeny per batch with kernel point K of order k */
 /* real isogeny: returns the new curve coefficient A, no point evaluation */
 /* dummy isogeny: returns the old curve coefficient A, no point evaluation */
-void lastxISOG(proj *A, proj const *K, uint64_t k, int mask)
+void lastxISOG(curve *E, proj const *K, uint64_t k, int mask)
 {
     assert (k >= 3);
     assert (k % 2 == 1);
 
-    fp tmp0, tmp1;
-    proj Aed, prod;
-    proj Acopy = *A;
+    fp tmp0, tmp1, Ksum, Kdif, ad, bc;
+    proj Aed = E->Aed, prod;
+    PRODUCTS(4);
 
-    fp_add3(&Aed.z, &A->z, &A->z);  //compute twisted Edwards curve coefficients
-    fp_add3(&Aed.x, &A->x, &Aed.z);
-    fp_sub3(&Aed.z, &A->x, &Aed.z);
-   
     fp_sub3(&prod.x, &K->x, &K->z);
     fp_add3(&prod.z, &K->x, &K->z);
 
     proj M[3] = {*K};
-    xDBL(&M[1], A, K);
+    xDBL(&M[1], E, K);
+
+    // xADD(M[i+1], M[i], K, M[i-1]) interleaved as in xISOG_n
+    Ksum = prod.z;
+    Kdif = prod.x;
 
     for (uint64_t i = 1; i < k / 2; ++i) {
 
-        if (i >= 2)
-            xADD(&M[i % 3], &M[(i - 1) % 3], K, &M[(i - 2) % 3]);
+        proj const *Mi = &M[i % 3], *Mp = &M[(i - 1) % 3];
+        proj *Mn = &M[(i + 1) % 3];
 
-	fp_sub3(&tmp1, &M[i % 3].x, &M[i % 3].z);
-    	fp_add3(&tmp0, &M[i % 3].x, &M[i % 3].z);
-	fp_mul2(&prod.x, &tmp1);
-        fp_mul2(&prod.z, &tmp0);
+        fp_sub3(&tmp1, &Mi->x, &Mi->z);
+        fp_add3(&tmp0, &Mi->x, &Mi->z);
+        PRODUCT(&prod.x, &prod.x, &tmp1);
+        PRODUCT(&prod.z, &prod.z, &tmp0);
+        if (i + 1 == k / 2) {  // no M[i+1] after the last step
+            MULTIPLY();
+            break;
+        }
+        OPCOUNT_INC(xadd);
+        PRODUCT(&ad, &tmp0, &Kdif);
+        PRODUCT(&bc, &tmp1, &Ksum);
+        MULTIPLY();
+
+        fp_add3(&tmp0, &ad, &bc);
+        fp_sub3(&tmp1, &ad, &bc);
+        PRODUCT(&tmp0, &tmp0, &tmp0);
+        PRODUCT(&tmp1, &tmp1, &tmp1);
+        MULTIPLY();
+        PRODUCT(&Mn->x, &Mp->z, &tmp0);
+        PRODUCT(&Mn->z, &Mp->x, &tmp1);
+        MULTIPLY();
 
     }
 
@@ -297,14 +704,13 @@ void lastxISOG(proj *A, proj const *K, uint64_t k, int mask)
     fp_mul2(&Aed.z, &prod.x);
     fp_mul2(&Aed.x, &prod.z);
 
-    //compute Montgomery params
-    fp_add3(&A->x, &Aed.x, &Aed.z);
-    fp_sub3(&A->z, &Aed.x, &Aed.z);
-    fp_add2(&A->x, &A->x);
+    // CONSTANT TIME : keep the old Edwards coefficients for dummy isogenies;
+    // E is recomputed from them either way instead of keeping a copy of E
+    fp_cswap(&Aed.x, &E->Aed.x, mask);
+    fp_cswap(&Aed.z, &E->Aed.z, mask);
 
-    // CONSTANT TIME : swap back
-    fp_cswap(&A->x, &Acopy.x, mask);
-    fp_cswap(&A->z, &Acopy.z, mask);
+    //compute Montgomery params and A24
+    curve_from_edwards(E, &Aed);
 
 }
 
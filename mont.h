@@ -1,6 +1,8 @@
 #ifndef MONT_H
 #define MONT_H
 
+#include <stddef.h>
+
 #include "u512.h"
 #include "fp.h"
 
@@ -10,11 +12,41 @@ typedef struct proj {
     fp z;
 } proj;
 
-void xDBL(proj *Q, proj const *A, proj const *P);
+/* curve coefficient together with the values derived from it, */
+/* kept in sync by curve_set() and the isogeny routines. */
+typedef struct curve {
+    proj A;     /* Montgomery (A : C) */
+    proj A24;   /* (A+2C : 4C) */
+    proj Aed;   /* twisted Edwards (A+2C : A-2C) */
+} curve;
+
+/* the temporaries of one lane of xMUL_n() */
+typedef struct ladder_lane {
+    proj R, P;
+    fp tmp[6];
+} ladder_lane;
+
+/* the temporaries of one point pushed through xISOG_matryoshka() */
+typedef struct isog_point {
+    fp sum, dif, t[2];
+    proj Q;
+} isog_point;
+
+void curve_set(curve *E, proj const *A);
+
+void xDBL(proj *Q, curve const *E, proj const *P);
 void xADD(proj *S, proj const *P, proj const *Q, proj const *PQ);
 void xDBLADD(proj *R, proj *S, proj const *P, proj const *Q, proj const *PQ, proj const *A);
-void xMUL(proj *Q, proj const *A, proj const *P, u512 const *k);
-void xISOG(proj *A, proj *P, proj *Pd, proj *K, uint64_t k, int mask);
-void lastxISOG(proj *A, proj const *K, uint64_t k, int bit);
+void xMUL(proj *Q, curve const *E, proj const *P, u512 const *k);
+void xMUL_n(proj *Q, curve const *E, proj const *P, u512 const *k, size_t n);
+void xMUL_n_with(proj *Q, curve const *E, proj const *P, u512 const *k, size_t n, bool affine, ladder_lane *w);
+void xMUL2(proj *Q, proj *Qd, curve const *E, proj const *P, proj const *Pd, u512 const *k);
+void xMUL_ct(proj *Q, curve const *E, proj const *P, u512 const *k, unsigned long bits);
+void xMUL_ct_n(proj *Q, curve const *E, proj const *P, u512 const *k, unsigned long bits, size_t n);
+void xISOG_n(curve *E, proj *points, size_t n, proj *K, uint64_t k, int mask);
+void xISOG(curve *E, proj *P, proj *Pd, proj *K, uint64_t k, int mask);
+void xISOG_matryoshka(curve *E, proj *points, size_t n, proj const *K, uint64_t k, uint64_t kmax, int mask,
+        isog_point *w);
+void lastxISOG(curve *E, proj const *K, uint64_t k, int bit);
 
 #endif
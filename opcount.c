@@ -0,0 +1,113 @@
+
+#include "opcount.h"
+
+#ifdef OPCOUNT
+
+#include <string.h>
+
+#include "csidh.h"
+#include "cycle.h"
+
+typedef struct region {
+    uint64_t calls;
+    uint64_t cycles;
+    opcount_ops ops;
+} region;
+
+opcount_ops opcount;
+
+static region phases[opcount_num_phases];
+static region per_prime[num_primes];
+
+static char const *phase_names[opcount_num_phases] = {
+    "elligator", "xMUL", "cofactor", "xISOG", "lastxISOG", "normalize",
+};
+
+void opcount_reset(void)
+{
+    memset(&opcount, 0, sizeof(opcount));
+    memset(phases, 0, sizeof(phases));
+    memset(per_prime, 0, sizeof(per_prime));
+}
+
+void opcount_begin(opcount_mark *m)
+{
+    m->ops = opcount;
+    m->ticks = getticks();
+}
+
+static void region_end(region *r, opcount_mark const *m)
+{
+    r->cycles += getticks() - m->ticks;
+    r->calls += 1;
+    r->ops.mul += opcount.mul - m->ops.mul;
+    r->ops.sq += opcount.sq - m->ops.sq;
+    r->ops.add += opcount.add - m->ops.add;
+    r->ops.inv += opcount.inv - m->ops.inv;
+    r->ops.issquare += opcount.issquare - m->ops.issquare;
+    r->ops.mul4 += opcount.mul4 - m->ops.mul4;
+    r->ops.mul8 += opcount.mul8 - m->ops.mul8;
+    r->ops.xdbl += opcount.xdbl - m->ops.xdbl;
+    r->ops.xadd += opcount.xadd - m->ops.xadd;
+    r->ops.xdbladd += opcount.xdbladd - m->ops.xdbladd;
+}
+
+void opcount_phase_end(enum opcount_phase phase, opcount_mark const *m)
+{
+    region_end(&phases[phase], m);
+}
+
+void opcount_prime_end(size_t i, opcount_mark const *m)
+{
+    region_end(&per_prime[i], m);
+}
+
+static void print_ops(FILE *f, opcount_ops const *ops, double d)
+{
+    fprintf(f, "%10.1lf %10.1lf %10.1lf %6.2lf %6.2lf %10.1lf %10.1lf %8.1lf %8.1lf %8.1lf",
+            ops->mul / d, ops->sq / d, ops->add / d, ops->inv / d, ops->issquare / d, ops->mul4 / d, ops->mul8 / d,
+            ops->xdbl / d, ops->xadd / d, ops->xdbladd / d);
+}
+
+/* everything divided by the number of calls to the measured function */
+void opcount_print(FILE *f, unsigned long calls)
+{
+    static char const *header = "%10s %10s %10s %6s %6s %10s %10s %8s %8s %8s";
+    uint64_t total = 0;
+    for (size_t i = 0; i < opcount_num_phases; ++i)
+        total += phases[i].cycles;
+
+    fprintf(f, "%-12s ", "per call");
+    fprintf(f, header, "mul", "sq", "add", "inv", "leg", "mul4", "mul8", "xDBL", "xADD", "xDBLADD");
+    fprintf(f, "\n%-12s ", "total");
+    print_ops(f, &opcount, calls);
+    fprintf(f, "\n\n%-12s %12s %6s %8s ", "phase", "cycles", "%", "calls");
+    fprintf(f, header, "mul", "sq", "add", "inv", "leg", "mul4", "mul8", "xDBL", "xADD", "xDBLADD");
+    fprintf(f, "\n");
+    for (size_t i = 0; i < opcount_num_phases; ++i) {
+        fprintf(f, "%-12s %12.0lf %6.2lf %8.1lf ", phase_names[i],
+                (double) phases[i].cycles / calls,
+                total ? 100. * phases[i].cycles / total : 0,
+                (double) phases[i].calls / calls);
+        print_ops(f, &phases[i].ops, calls);
+        fprintf(f, "\n");
+    }
+
+    fprintf(f, "\n%-12s %12s %6s %8s ", "prime", "cycles", "%", "visits");
+    fprintf(f, header, "mul", "sq", "add", "inv", "leg", "mul4", "mul8", "xDBL", "xADD", "xDBLADD");
+    fprintf(f, "\n");
+    for (size_t i = 0; i < num_primes; ++i) {
+        fprintf(f, "%-12u %12.0lf %6.2lf %8.1lf ", primes[i],
+                (double) per_prime[i].cycles / calls,
+                total ? 100. * per_prime[i].cycles / total : 0,
+                (double) per_prime[i].calls / calls);
+        print_ops(f, &per_prime[i].ops, calls);
+        fprintf(f, "\n");
+    }
+}
+
+#else
+
+typedef int opcount_disabled; /* ISO C wants a non-empty translation unit */
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef OPCOUNT_H
+#define OPCOUNT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/* field-operation counters and phase timers, enabled with -DOPCOUNT. */
+/* otherwise all hooks below compile to nothing. */
+
+enum opcount_phase {
+    OPCOUNT_ELLIGATOR,
+    OPCOUNT_XMUL,       /* multiplication of the Elligator points by k */
+    OPCOUNT_COFACTOR,   /* kernel point and [l]Pd for each prime */
+    OPCOUNT_XISOG,
+    OPCOUNT_LASTXISOG,
+    OPCOUNT_NORMALIZE,
+    opcount_num_phases
+};
+
+#ifdef OPCOUNT
+
+typedef struct opcount_ops {
+    uint64_t mul, sq, add, inv, issquare, mul4, mul8;
+    uint64_t xdbl, xadd, xdbladd;
+} opcount_ops;
+
+typedef struct opcount_mark {
+    uint64_t ticks;
+    opcount_ops ops;
+} opcount_mark;
+
+extern opcount_ops opcount;
+
+void opcount_reset(void);
+void opcount_begin(opcount_mark *m);
+void opcount_phase_end(enum opcount_phase phase, opcount_mark const *m);
+void opcount_prime_end(size_t i, opcount_mark const *m);
+void opcount_print(FILE *f, unsigned long calls);
+
+#define OPCOUNT_INC(op) (++opcount.op)
+#define OPCOUNT_TIME(phase, stmt) do { opcount_mark m_; opcount_begin(&m_); stmt; opcount_phase_end(phase, &m_); } while (0)
+#define OPCOUNT_BEGIN(m) opcount_mark m; opcount_begin(&m)
+#define OPCOUNT_PHASE(phase, m) opcount_phase_end(phase, &m)
+#define OPCOUNT_PRIME(i, m) opcount_prime_end(i, &m)
+
+#else
+
+#define OPCOUNT_INC(op)
+#define OPCOUNT_TIME(phase, stmt) do { stmt; } while (0)
+#define OPCOUNT_BEGIN(m)
+#define OPCOUNT_PHASE(phase, m)
+#define OPCOUNT_PRIME(i, m)
+
+#endif
+
+#endif
@@ -0,0 +1,139 @@
+/* generated by python3 genparams.py p1024 130, do not edit */
+
+#include "ctidh.h"
+
+/* p = 4 * 3 * 5 * 7 * 11 * 13 * 17 * 19 * 23 * 29 * 31 * 37 * 41 * 43 * 47 * 53 *
+ * 59 * 61 * 67 * 71 * 73 * 79 * 83 * 89 * 97 * 101 * 103 * 107 * 109 * 113 * 127 * 131 *
+ * 137 * 139 * 149 * 151 * 157 * 163 * 167 * 173 * 179 * 181 * 191 * 193 * 197 * 199 * 211 * 223 *
+ * 227 * 229 * 233 * 239 * 241 * 251 * 257 * 263 * 269 * 271 * 277 * 281 * 283 * 293 * 307 * 311 *
+ * 313 * 317 * 331 * 337 * 347 * 349 * 353 * 359 * 367 * 373 * 379 * 383 * 389 * 397 * 401 * 409 *
+ * 419 * 421 * 431 * 433 * 439 * 443 * 449 * 457 * 461 * 463 * 467 * 479 * 487 * 491 * 499 * 503 *
+ * 509 * 521 * 523 * 541 * 547 * 557 * 563 * 569 * 571 * 577 * 587 * 593 * 599 * 601 * 607 * 613 *
+ * 617 * 619 * 631 * 641 * 643 * 647 * 653 * 659 * 661 * 673 * 677 * 683 * 691 * 701 * 709 * 719 *
+ * 727 * 733 * 983 - 1 */
+
+const unsigned primes[num_primes] = {
+	983, 733, 727, 719, 709, 701, 691, 683, 677, 673, 661, 659, 653, 647, 643, 641,
+	631, 619, 617, 613, 607, 601, 599, 593, 587, 577, 571, 569, 563, 557, 547, 541,
+	523, 521, 509, 503, 499, 491, 487, 479, 467, 463, 461, 457, 449, 443, 439, 433,
+	431, 421, 419, 409, 401, 397, 389, 383, 379, 373, 367, 359, 353, 349, 347, 337,
+	331, 317, 313, 311, 307, 293, 283, 281, 277, 271, 269, 263, 257, 251, 241, 239,
+	233, 229, 227, 223, 211, 199, 197, 193, 191, 181, 179, 173, 167, 163, 157, 151,
+	149, 139, 137, 131, 127, 113, 109, 107, 103, 101, 97, 89, 83, 79, 73, 71,
+	67, 61, 59, 53, 47, 43, 41, 37, 31, 29, 23, 19, 17, 13, 11, 7,
+	5, 3,
+};
+
+const int8_t default_max[num_primes] = {
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	2, 2,
+};
+
+/* CTIDH batches, bounds for a key space of 2^258.46 */
+const uint8_t ctidh_batches[num_primes] = {
+	129, 128, 127, 126, 125, 124, 123, /* 3 5 7 11 13 17 19 */
+	122, 121, 120, 119, 118, 117, 116, /* 23 29 31 37 41 43 47 */
+	115, 114, 113, 112, 111, 110, 109, /* 53 59 61 67 71 73 79 */
+	108, 107, 106, 105, 104, 103, 102, /* 83 89 97 101 103 107 109 */
+	101, 100, 99, 98, 97, 96, 95, /* 113 127 131 137 139 149 151 */
+	94, 93, 92, 91, 90, 89, 88, /* 157 163 167 173 179 181 191 */
+	87, 86, 85, 84, 83, 82, 81, /* 193 197 199 211 223 227 229 */
+	80, 79, 78, 77, 76, 75, 74, /* 233 239 241 251 257 263 269 */
+	73, 72, 71, 70, 69, 68, 67, /* 271 277 281 283 293 307 311 */
+	66, 65, 64, 63, 62, 61, 60, /* 313 317 331 337 347 349 353 */
+	59, 58, 57, 56, 55, 54, 53, /* 359 367 373 379 383 389 397 */
+	52, 51, 50, 49, 48, 47, 46, /* 401 409 419 421 431 433 439 */
+	45, 44, 43, 42, 41, 40, 39, /* 443 449 457 461 463 467 479 */
+	38, 37, 36, 35, 34, 33, 32, /* 487 491 499 503 509 521 523 */
+	31, 30, 29, 28, 27, 26, 25, 24, /* 541 547 557 563 569 571 577 587 */
+	23, 22, 21, 20, 19, 18, 17, 16, /* 593 599 601 607 613 617 619 631 */
+	15, 14, 13, 12, 11, 10, 9, 8, /* 641 643 647 653 659 661 673 677 */
+	7, 6, 5, 4, 3, 2, 1, 0, /* 683 691 701 709 719 727 733 983 */
+};
+const uint8_t ctidh_batch_start[ctidh_num_batches + 1] = {0, 7, 14, 21, 28, 35, 42, 49, 56, 63, 70, 77, 84, 91, 98, 106, 114, 122, 130};
+const int8_t ctidh_max[ctidh_num_batches] = {10, 10, 9, 9, 8, 7, 7, 6, 6, 6, 5, 5, 5, 4, 4, 4, 4, 3};
+
+/* floor(4 sqrt(p)) */
+const u512 four_sqrt_p = { .c = {
+	0xeba75c5815bb0d57, 0xfec8564a9ae457c6, 0xe362e1c2334bd738, 0x56f74a246ef0a30e,
+	0x4a598c9571aeb858, 0xc5617b211ccad355, 0x4fb69e4928ccc442, 0xf643475c7915859c,
+	0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000,
+	0x0000000000000000, 0x0000000000000000, 0x0000000000000000, 0x0000000000000000 } };
+
+/* x-coordinate of a point of full order on E_0 */
+const u512 p_order = { .c = {
+	0x3536c80f01ec6846, 0xe4b7c28b161f2257, 0x18e02d33dd60bbba, 0x0b4585349a7d5b44,
+	0x3284fbef87ae24e3, 0x9da32b864561c8c5, 0x76c22fcb99e6f703, 0x82cfdf42246a5b3d,
+	0x35e010c9b6aea19e, 0xf1d629006aafe593, 0xba9c97fab62e22e5, 0xc3ae7eb00b5b06ed,
+	0x04c9ab390ffdb0bb, 0xa2c2eace1308c4ab, 0xc830cca777f723b1, 0x04fa66577af5708b } };
+
+/* round 0 of action() from E_0 with default_num_batches, see csidh.h */
+const u512 base_points[6] = {
+	{ .c = {
+		0x99e4267f2b83ed35, 0xd467885bf5196562, 0x2d6b8805d9c1a8ae, 0x689315e3d120406f,
+		0x1221d662c3ff87a7, 0x97cf54c6ae324b0d, 0xbd4251df2e115cb4, 0x0b7a0dc4040cc36e,
+		0x4a83fa160e6f8dc3, 0x89d848d44e789c2a, 0x0841442cf6b0d52b, 0xbff7ed6126e6c139,
+		0x7d0dfeba7e965059, 0x1543644d80484d31, 0x055468d4148c8b94, 0x06e9ecf228d9367f } },
+	{ .c = {
+		0x41ff25d5355f771e, 0xcd70968fc723ceeb, 0x23e01f26df16f724, 0x5a37a0bd1167b14e,
+		0x5208f3ea9631af62, 0xd362278d8321d433, 0xfc3a04f2b0709130, 0xfdfece2ad4fd67e9,
+		0x2b8db33981d48ebc, 0x6e3990efcb73e6ff, 0x452b151d94275802, 0x3075f4e5f6127735,
+		0x8975d06b5c9b5d02, 0x0c28be6f06a9ccd6, 0xd34983b37b7b6043, 0x07e468fb1996dc2a } },
+	{ .c = {
+		0xf6dd81d17bb4be57, 0xdc8f7ada22b40d86, 0x64ad3cbd64ae52f1, 0xb6a5f84665918127,
+		0x633fe814eda88d76, 0x1ae0d9ec4a7e2684, 0x932fc5a8a077629b, 0x5185785851296439,
+		0x3fe1ec739296dff9, 0x36cf88664c678a5f, 0xe53c626a4d91c2ab, 0x988b42e6b8255588,
+		0x3620eb919230df4a, 0xb3d5e1b7f9ef7684, 0x9a136496625956fc, 0x02b92961a59f0d89 } },
+	{ .c = {
+		0xe505ca82e52ea5fc, 0xc548a411998926c6, 0xec9e6a6f542a4ce1, 0x0c24be5a7cf67095,
+		0x00eae2386c88a993, 0x5050a267e6d5f8bc, 0x264c91293e0a8b4a, 0xb7f3639687e0c71f,
+		0x362fc0dbfdad3c86, 0xc142515dcd84f8ca, 0x682ff6e03d466a82, 0x57e29f6064d3e2e5,
+		0xd062e3944900ce11, 0x6d9641048d02a383, 0x3e8a87f12dae94da, 0x0c152c8b9cd10520 } },
+	{ .c = {
+		0xb46438b79b2ce404, 0xaae3a0d70c2d88a1, 0x670e17de52559902, 0x06c3ecebac303bd9,
+		0xbece35b77fdb6097, 0x317f8e85baf476d3, 0x6f0533fd5942da1e, 0x0098d0dbbbdbfe34,
+		0xfe8324d0226ff498, 0x39b3a260c20ab962, 0x5ce815868edffde9, 0xeda2b79e3e3370ee,
+		0xb974821f0c4de21c, 0x7b75a1ab16489421, 0xf9c775cdd8450486, 0x0202c52ec5a68069 } },
+	{ .c = {
+		0x277f139cc5b6804f, 0xf6f47e14b00fabac, 0xea3d8f4e668306d0, 0xbc06c9b53657b5e3,
+		0xa55c9495da55d672, 0x39b1edce765fa86c, 0x4a7722d4853f13c7, 0x08e00b131d2e2d24,
+		0x778e887f6dd427e8, 0xbe5e376357e1c9c6, 0xf08443c3fbf82f44, 0x02cb2aa8dec5c77f,
+		0x4d0f4d06cee3cb3f, 0xa5f6811170a985e6, 0xded676b9b7c2e750, 0x0ccb90be7cc9923f } },
+};
+
+/* field constants for fp_generic.c */
+const u512 fp_p = { .c = {
+	0xdbe34c5460e36453, 0xa1d81eebbc3d344d, 0x514ba72cb8d89fd3, 0xc2cab6a0e287f1bd,
+	0x642aca4d5a313709, 0x6b317c5431541f40, 0xb97c56d1de81ede5, 0x0978dbeed90a2b58,
+	0x7611ad4f90441c80, 0xf811d9c419ec8329, 0x4d6c594a8ad82d2d, 0xf06de2471cf9386e,
+	0x0683cf25db31ad5b, 0x216c22bc86f21a08, 0xd89dec879007ebd7, 0x0ece55ed427012a9 } };
+const u512 fp_r_squared = { .c = {
+	0xd6b8f146ec5055af, 0x68ac5d7707ccb03a, 0x1322c9b9837dca17, 0x4f2940830c1d2b35,
+	0x8c1a56e5bf96471a, 0x6cdde00636c4f801, 0x9365ec4fa327c9ac, 0xa0056a67c1de0e82,
+	0x8aa6fa7e6811faa8, 0x9aad9631bb760403, 0x156b34c683839b9d, 0xa5ae047480992b2c,
+	0xc124d930289048b5, 0x4f8a8344bbe56288, 0xe1a2eb1d838b8237, 0x057162f911ca93a3 } };
+const u512 fp_p_minus_2 = { .c = {
+	0xdbe34c5460e36451, 0xa1d81eebbc3d344d, 0x514ba72cb8d89fd3, 0xc2cab6a0e287f1bd,
+	0x642aca4d5a313709, 0x6b317c5431541f40, 0xb97c56d1de81ede5, 0x0978dbeed90a2b58,
+	0x7611ad4f90441c80, 0xf811d9c419ec8329, 0x4d6c594a8ad82d2d, 0xf06de2471cf9386e,
+	0x0683cf25db31ad5b, 0x216c22bc86f21a08, 0xd89dec879007ebd7, 0x0ece55ed427012a9 } };
+const u512 fp_p_minus_1_halves = { .c = {
+	0xedf1a62a3071b229, 0xd0ec0f75de1e9a26, 0xa8a5d3965c6c4fe9, 0xe1655b507143f8de,
+	0x32156526ad189b84, 0xb598be2a18aa0fa0, 0x5cbe2b68ef40f6f2, 0x04bc6df76c8515ac,
+	0xbb08d6a7c8220e40, 0xfc08ece20cf64194, 0x26b62ca5456c1696, 0xf836f1238e7c9c37,
+	0x0341e792ed98d6ad, 0x90b6115e43790d04, 0xec4ef643c803f5eb, 0x07672af6a1380954 } };
+const uint64_t fp_inv_min_p_mod_r = 0xd2c2c24160038025;
+
+const fp fp_0 = { { .c = { 0 } } };
+const fp fp_1 = { { .c = {
+	0x65e7ee6590e6567d, 0x40a5f2587fef86d4, 0x99f9e607b99d62f2, 0x1089df50f4f8f26d,
+	0x592890dd02bb585a, 0xe1b6be68b969ecb9, 0xaebe3c10395f33c3, 0x5ef9652396531f1b,
+	0x28d37db76b7a1b7f, 0x86d089fa474b4a3f, 0xdbce120cc7a4fff2, 0x08b3f947137340ac,
+	0x913f3e7c71b37ce5, 0xc7d1b17b09ec4577, 0x9d834aff6f7956b6, 0x044c4b3e968ec2b8 } } }; /* 2^1024 mod p */
@@ -0,0 +1,16 @@
+/* generated by python3 genparams.py p1024 130, do not edit */
+
+#ifndef P1024_H
+#define P1024_H
+
+#define LIMBS 16
+#define PBITS 1020
+#define num_primes 130
+
+#define default_num_batches 3
+#define default_my 8
+#define default_num_isogenies 260
+
+#define ctidh_num_batches 18
+
+#endif
@@ -0,0 +1,69 @@
+
+#include "ctidh.h"
+
+/* CSIDH-512: p = 4 * 3 * 5 * ... * 373 * 587 - 1; the field constants
+ * are in fp.S, the modulus is repeated here for validate(). */
+
+const u512 fp_p = { .c = { 0x1b81b90533c6c87b, 0xc2721bf457aca835, 0x516730cc1f0b4f25, 0xa7aac6c567f35507,
+		0x5afbfcc69322c9cd, 0xb42d083aedc88c42, 0xfc8ab0d15e3e4c4a, 0x65b48e8f740f89bf } };
+
+const unsigned primes[num_primes] = {    359, 353, 349, 347, 337, 331, 317, 313, 311,
+307, 293, 283, 281, 277, 271, 269, 263, 257, 251, 241, 239, 233, 229,
+227, 223, 211, 199, 197, 193, 191, 181, 179, 173, 167, 163, 157, 151,
+149, 139, 137, 131, 127, 113, 109, 107, 103, 101, 97, 89, 83, 79, 73,
+71, 67, 61, 59, 53, 47, 43, 41, 37, 31, 29, 23, 19, 17, 13, 11, 7, 5, 3,
+587, 373, 367 };
+
+const int8_t default_max[num_primes] = {2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+				4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 5, 5, 5, 5, 5,
+				5, 5, 6, 6, 6, 6, 6, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 8,
+				9, 9, 9, 10, 10, 10, 10, 9, 8, 8, 8, 7, 7, 7, 7, 7, 6, 5,
+				1, 2, 2};
+
+/* CTIDH: the batch sizes of CTIDH-512, bounds for a key space of 2^256.09 */
+const uint8_t ctidh_batches[num_primes] = {
+		70, 69, /* 3 5 */
+		68, 67, 66, /* 7 11 13 */
+		65, 64, 63, 62, 61, /* 17 19 23 29 31 */
+		60, 59, 58, 57, /* 37 41 43 47 */
+		56, 55, 54, 53, 52, 51, /* 53 59 61 67 71 73 */
+		50, 49, 48, 47, 46, 45, /* 79 83 89 97 101 103 */
+		44, 43, 42, 41, 40, 39, 38, /* 107 109 113 127 131 137 139 */
+		37, 36, 35, 34, 33, 32, 31, /* 149 151 157 163 167 173 179 */
+		30, 29, 28, 27, 26, 25, 24, 23, /* 181 191 193 197 199 211 223 227 */
+		22, 21, 20, 19, 18, 17, 16, /* 229 233 239 241 251 257 263 */
+		15, 14, 13, 12, 11, 10, 9, 8, /* 269 271 277 281 283 293 307 311 */
+		7, 6, 5, 4, 3, 2, /* 313 317 331 337 347 349 */
+		1, 0, 73, 72, /* 353 359 367 373 */
+		71, /* 587 */
+};
+const uint8_t ctidh_batch_start[ctidh_num_batches + 1] = {0, 2, 5, 10, 14, 20, 26, 33, 40, 48, 55, 63, 69, 73, 74};
+const int8_t ctidh_max[ctidh_num_batches] = {11, 16, 18, 18, 18, 18, 18, 18, 18, 18, 17, 12, 7, 1};
+
+const u512 four_sqrt_p = { { 0x85e2579c786882cf, 0x4e3433657e18da95,
+		0x850ae5507965a0b3, 0xa15bc4e676475964, } };
+
+/* x-coordinate of a point of full order on E_0 */
+const u512 p_order = { .c = {0x24403b2c196b9323, 0x8a8759a31723c208, 0xb4a93a543937992b, 0xcdd1f791dc7eb773, 0xff470bd36fd7823b, 0xfbcf1fc39d553409, 0x9478a78dd697be5c, 0x0ed9b5fb0f251816}};
+
+/* round 0 of action() from E_0 with default_num_batches, see csidh.h */
+const u512 base_points[6] = {
+	{ .c = {
+		0x7a4f77facef62413, 0x4611fde089cd9b3d, 0x741ff0740fe2edcd, 0x488ab6755b021f14,
+		0x52448e9b325ca022, 0x05f9ba40821664b7, 0xbb4e844ddac70bc0, 0x4af08afe8edb7c4b } },
+	{ .c = {
+		0xa132410a64d0a468, 0x7c601e13cddf0cf7, 0xdd4740580f286158, 0x5f2010500cf135f2,
+		0x08b76e2b60c629ab, 0xae334dfa6bb2278b, 0x413c2c838377408a, 0x1ac40390e5340d74 } },
+	{ .c = {
+		0x6e1ead3a25d0b3fe, 0xa7567a4801281a12, 0xd99963d8350a7df3, 0x44c9831f2b694242,
+		0xd4537e22ea7ecf48, 0x818388e7ded89a0e, 0xbc77f31aece606c1, 0x0e96cdcb572fef50 } },
+	{ .c = {
+		0xad630bcb0df6147d, 0x1b1ba1ac56848e22, 0x77cdccf3ea00d132, 0x62e143a63c8a12c4,
+		0x86a87ea3a8a3fa85, 0x32a97f530eeff233, 0x4012bdb671584589, 0x571dc0c41cdf9a6f } },
+	{ .c = {
+		0x09cce421a698c614, 0xab13e03db90c0247, 0x834b819580ebcd58, 0x329bec1fbcd61072,
+		0x66d6462d1fdabee7, 0xd4bf050d604642c6, 0xe73a8757e72e566f, 0x4cb2accaafffa3e7 } },
+	{ .c = {
+		0x11b4d4e38d2e0267, 0x175e3bb69ea0a5ee, 0xce1baf369e1f81cd, 0x750edaa5ab1d4494,
+		0xf425b69973480ae6, 0xdf6e032d8d82497b, 0x15502979770ff5da, 0x1901e1c4c40fe5d8 } },
+};
@@ -0,0 +1,16 @@
+#ifndef P512_H
+#define P512_H
+
+/* CSIDH-512, field arithmetic in fp.S and u512.S */
+
+#define LIMBS 8
+#define PBITS 511
+#define num_primes 74
+
+#define default_num_batches 3
+#define default_my 8
+#define default_num_isogenies 404
+
+#define ctidh_num_batches 14
+
+#endif
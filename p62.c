@@ -0,0 +1,64 @@
+/* generated by python3 genparams.py p62 14, do not edit */
+
+#include "ctidh.h"
+
+/* p = 4 * 3 * 5 * 7 * 11 * 13 * 17 * 19 * 23 * 29 * 31 * 37 * 41 * 43 * 97 - 1 */
+
+const unsigned primes[num_primes] = {
+	97, 43, 41, 37, 31, 29, 23, 19, 17, 13, 11, 7, 5, 3,
+};
+
+const int8_t default_max[num_primes] = {
+	2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+};
+
+/* CTIDH batches, bounds for a key space of 2^31.11 */
+const uint8_t ctidh_batches[num_primes] = {
+	13, 12, /* 3 5 */
+	11, 10, /* 7 11 */
+	9, 8, /* 13 17 */
+	7, 6, /* 19 23 */
+	5, 4, 3, /* 29 31 37 */
+	2, 1, 0, /* 41 43 97 */
+};
+const uint8_t ctidh_batch_start[ctidh_num_batches + 1] = {0, 2, 4, 6, 8, 11, 14};
+const int8_t ctidh_max[ctidh_num_batches] = {5, 4, 4, 3, 4, 1};
+
+/* floor(4 sqrt(p)) */
+const u512 four_sqrt_p = { .c = {
+	0x000000017bd4cb7a } };
+
+/* x-coordinate of a point of full order on E_0 */
+const u512 p_order = { .c = {
+	0x1bf854a0fbe065f0 } };
+
+/* round 0 of action() from E_0 with default_num_batches, see csidh.h */
+const u512 base_points[6] = {
+	{ .c = {
+		0x212425656c6b5b33 } },
+	{ .c = {
+		0x0214d6d07387a768 } },
+	{ .c = {
+		0x0958ff47b1b9192d } },
+	{ .c = {
+		0x19dffcee2e39e96e } },
+	{ .c = {
+		0x1f3301d659687eec } },
+	{ .c = {
+		0x0405fa5f868a83af } },
+};
+
+/* field constants for fp_generic.c */
+const u512 fp_p = { .c = {
+	0x2338fc35dff3029b } };
+const u512 fp_r_squared = { .c = {
+	0x062a1da8d15871fd } };
+const u512 fp_p_minus_2 = { .c = {
+	0x2338fc35dff30299 } };
+const u512 fp_p_minus_1_halves = { .c = {
+	0x119c7e1aeff9814d } };
+const uint64_t fp_inv_min_p_mod_r = 0xe6671eb7d2f3ec6d;
+
+const fp fp_0 = { { .c = { 0 } } };
+const fp fp_1 = { { .c = {
+	0x09711a86e05aedc3 } } }; /* 2^64 mod p */
@@ -0,0 +1,16 @@
+/* generated by python3 genparams.py p62 14, do not edit */
+
+#ifndef P62_H
+#define P62_H
+
+#define LIMBS 1
+#define PBITS 62
+#define num_primes 14
+
+#define default_num_batches 3
+#define default_my 8
+#define default_num_isogenies 28
+
+#define ctidh_num_batches 6
+
+#endif
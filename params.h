@@ -0,0 +1,15 @@
+#ifndef PARAMS_H
+#define PARAMS_H
+
+/* the parameter set is chosen at compile time, CSIDH-512 by default;
+ * others are written by genparams.py and use fp_generic.c and
+ * u512_generic.c instead of the assembly. */
+#if defined(P1024)
+#include "p1024.h"
+#elif defined(P62)
+#include "p62.h"
+#else
+#include "p512.h"
+#endif
+
+#endif
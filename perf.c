@@ -0,0 +1,97 @@
+
+#include "perf.h"
+
+char const *perf_names[perf_num_counters] = {
+    "cycles", "instructions", "branch_misses", "l1d_misses",
+};
+
+#ifdef __linux__
+
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+static int fds[perf_num_counters] = { -1, -1, -1, -1 };
+
+static int open_counter(uint32_t type, uint64_t config)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/* true if at least one counter could be opened */
+bool perf_open(void)
+{
+    bool any = false;
+
+    fds[PERF_CYCLES] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    fds[PERF_INSTRUCTIONS] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    fds[PERF_BRANCH_MISSES] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    fds[PERF_L1D_MISSES] = open_counter(PERF_TYPE_HW_CACHE,
+            PERF_COUNT_HW_CACHE_L1D
+            | PERF_COUNT_HW_CACHE_OP_READ << 8
+            | PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+    for (size_t i = 0; i < perf_num_counters; ++i)
+        any |= fds[i] >= 0;
+    return any;
+}
+
+void perf_close(void)
+{
+    for (size_t i = 0; i < perf_num_counters; ++i) {
+        if (fds[i] >= 0)
+            close(fds[i]);
+        fds[i] = -1;
+    }
+}
+
+bool perf_available(enum perf_counter c)
+{
+    return fds[c] >= 0;
+}
+
+void perf_start(void)
+{
+    for (size_t i = 0; i < perf_num_counters; ++i) {
+        if (fds[i] >= 0) {
+            ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+void perf_stop(uint64_t *values)
+{
+    for (size_t i = 0; i < perf_num_counters; ++i) {
+        values[i] = 0;
+        if (fds[i] >= 0) {
+            ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fds[i], &values[i], sizeof(values[i])) != sizeof(values[i]))
+                values[i] = 0;
+        }
+    }
+}
+
+#else
+
+bool perf_open(void) { return false; }
+void perf_close(void) { }
+bool perf_available(enum perf_counter c) { (void) c; return false; }
+void perf_start(void) { }
+void perf_stop(uint64_t *values)
+{
+    for (size_t i = 0; i < perf_num_counters; ++i)
+        values[i] = 0;
+}
+
+#endif
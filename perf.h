@@ -0,0 +1,28 @@
+#ifndef PERF_H
+#define PERF_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* hardware performance counters through Linux perf_event_open. */
+/* perf_open() fails softly: in containers or with a restrictive
+ * perf_event_paranoid the counters are simply unavailable. */
+
+enum perf_counter {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_BRANCH_MISSES,
+    PERF_L1D_MISSES,
+    perf_num_counters
+};
+
+extern char const *perf_names[perf_num_counters];
+
+bool perf_open(void);
+void perf_close(void);
+bool perf_available(enum perf_counter c);
+
+void perf_start(void);
+void perf_stop(uint64_t *values); /* perf_num_counters entries */
+
+#endif
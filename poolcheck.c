@@ -0,0 +1,165 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#include "keypool.h"
+
+/* stress test of the key pool with many producers and consumers: the
+ * refill threads fill in numbered entries instead of keys, the consumers
+ * take them as fast as they can. no entry may be handed out twice or torn,
+ * the depth stays within the capacity, the refill threads go to sleep at
+ * the high watermark and leave at least the low one, and at the end the pool's counters add up to what
+ * the consumers saw: generated = taken + dropped + depth.
+ * usage: ./poolcheck [-n takes] [-c consumers] [-r refill threads] [-p capacity] */
+
+static unsigned long num_takes = 100000;
+static size_t capacity = 64;
+
+static keypool pool;
+static _Atomic uint64_t next_id;
+static _Atomic uint8_t *seen;
+static uint64_t num_ids;
+static _Atomic unsigned long takes, taken, misses, failures;
+
+static void fail(char const *what, uint64_t value) {
+	if (atomic_fetch_add(&failures, 1) < 10)
+		fprintf(stderr, "%s (%llu)\n", what, (unsigned long long) value);
+}
+
+/* the id in the exponents and in the public key */
+static void generate(keypool_entry *entry) {
+	uint64_t id = atomic_fetch_add(&next_id, 1);
+	memset(entry, 0, sizeof(*entry));
+	memcpy(entry->priv.e, &id, sizeof(id));
+	memcpy(&entry->pub.A, &id, sizeof(id));
+}
+
+static void *consume(void *arg) {
+	(void) arg;
+	keypool_entry entry;
+	keypool_stats s;
+
+	while (atomic_fetch_add(&takes, 1) < num_takes) {
+		if (!keypool_take(&pool, &entry)) {
+			atomic_fetch_add(&misses, 1);
+			sched_yield();
+			continue;
+		}
+		atomic_fetch_add(&taken, 1);
+
+		uint64_t id, check;
+		memcpy(&id, entry.priv.e, sizeof(id));
+		memcpy(&check, &entry.pub.A, sizeof(check));
+		if (id != check)
+			fail("torn", id);
+		else if (id >= num_ids)
+			fail("never generated", id);
+		else if (atomic_exchange(&seen[id], 1))
+			fail("handed out twice", id);
+		keypool_release(&entry);
+
+		if (!(id & 1023)) {
+			keypool_stats_get(&pool, &s);
+			if (s.depth > pool.params.capacity)
+				fail("depth above the capacity", s.depth);
+		}
+	}
+	return NULL;
+}
+
+static void sleep_ms(long ms) {
+	nanosleep(&(struct timespec) { ms / 1000, ms % 1000 * 1000000 }, NULL);
+}
+
+int main(int argc, char **argv) {
+	unsigned long num_consumers = 4;
+	keypool_params params = {
+		.num_threads = 4,
+		.max_exponent = default_max,
+		.generate = generate,
+	};
+	keypool_stats s;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "n:c:r:p:")) != -1) {
+		switch (opt) {
+		case 'n': num_takes = strtoul(optarg, NULL, 10); break;
+		case 'c': num_consumers = strtoul(optarg, NULL, 10); break;
+		case 'r': params.num_threads = strtoul(optarg, NULL, 10); break;
+		case 'p': capacity = strtoul(optarg, NULL, 10); break;
+		default:
+			fprintf(stderr, "usage: %s [-n takes] [-c consumers] [-r refill threads] [-p capacity]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (!num_consumers || !capacity) {
+		fprintf(stderr, "need consumers and capacity > 0\n");
+		return 1;
+	}
+
+	params.capacity = capacity;
+	params.low_watermark = capacity / 4;
+	params.high_watermark = capacity * 3 / 4;
+	num_ids = num_takes + 4 * capacity + params.num_threads;
+	if (!(seen = calloc(num_ids, sizeof(*seen)))) {
+		fprintf(stderr, "out of memory\n");
+		return 1;
+	}
+	if (!keypool_init(&pool, &params)) {
+		fprintf(stderr, "cannot start the key pool\n");
+		return 1;
+	}
+
+	pthread_t threads[num_consumers];
+	for (unsigned long i = 0; i < num_consumers; ++i)
+		if (pthread_create(&threads[i], NULL, consume, NULL)) {
+			fprintf(stderr, "cannot start consumer %lu\n", i);
+			return 1;
+		}
+	for (unsigned long i = 0; i < num_consumers; ++i)
+		pthread_join(threads[i], NULL);
+
+	/* the refill threads go back to sleep; below the low watermark they
+	 * would have been woken up and refilled up to the high one */
+	uint64_t generated;
+	int quiet = 0;
+	for (int i = 0; i < 5000 && quiet < 100; ++i) {
+		keypool_stats_get(&pool, &s);
+		generated = s.generated;
+		sleep_ms(1);
+		keypool_stats_get(&pool, &s);
+		quiet = s.generated == generated ? quiet + 1 : 0;
+	}
+	if (quiet < 100)
+		fail("refill threads do not go to sleep", s.generated);
+	if (s.depth < params.low_watermark || s.depth > pool.params.capacity)
+		fail("depth outside the watermarks after refilling", s.depth);
+
+	keypool_destroy(&pool);  /* the counters stay valid */
+	keypool_stats_get(&pool, &s);
+
+	printf("%lu consumers, %zu refill threads, capacity %zu\n",
+			num_consumers, params.num_threads, pool.params.capacity);
+	printf("  generated %10llu\n", (unsigned long long) s.generated);
+	printf("  taken     %10llu\n", (unsigned long long) s.taken);
+	printf("  misses    %10llu\n", (unsigned long long) s.misses);
+	printf("  dropped   %10llu\n", (unsigned long long) s.dropped);
+	printf("  depth     %10zu\n", s.depth);
+
+	if (s.taken != atomic_load(&taken) || s.misses != atomic_load(&misses))
+		fail("pool counters differ from the consumers'", s.taken);
+	if (s.generated != s.taken + s.dropped + s.depth)
+		fail("generated != taken + dropped + depth", s.generated);
+	if (s.generated != atomic_load(&next_id))
+		fail("generated differs from the entries made", s.generated);
+
+	free(seen);
+	unsigned long f = atomic_load(&failures);
+	printf("%s\n", f ? "FAILED" : "ok");
+	return !!f;
+}
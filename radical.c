@@ -0,0 +1,429 @@
+#include <string.h>
+#include <assert.h>
+
+#include "radical.h"
+#include "mont.h"
+#include "csidh.h"
+
+/* Castryck, Decru, Vercauteren, "Radical isogenies". */
+/* a point P of order l on y^2 + a1 xy + a3 y = x^3 + a2 x^2 is moved to */
+/* (0, 0); the codomain of the isogeny with kernel <P> is again of this */
+/* form, with the next kernel point at (0, 0), and its coefficients are */
+/* rational in an l-th root of the old ones. all l-th roots are unique as */
+/* l does not divide p - 1. */
+
+bool radical_supported(uint64_t l)
+{
+    return l == 3 || l == 5 || l == 7;
+}
+
+/* q = a / d, returns a mod d */
+static uint64_t u512_div_64(u512 *q, u512 const *a, uint64_t d)
+{
+    unsigned __int128 t = 0;
+    for (size_t i = LIMBS; i--; ) {
+        t = t << 64 | a->c[i];
+        q->c[i] = t / d;
+        t %= d;
+    }
+    return t;
+}
+
+/* x^(1/l) = x^e for e = (k (p-1) + 1) / l */
+static void root_exponent(u512 *e, uint64_t l)
+{
+    u512 q, t;
+    uint64_t r, k = 1;
+    u512_sub3(&t, &fp_p, &u512_1);
+    r = u512_div_64(&q, &t, l);
+    assert (r);
+    while ((k * r + 1) % l)
+        ++k;
+    u512_mul3_64(e, &q, k);
+    u512_set(&t, (k * r + 1) / l);
+    u512_add3(e, e, &t);
+}
+
+/* 1/d = (p+1)/d for d dividing p+1 */
+static void fp_inv_small(fp *x, uint64_t d)
+{
+    u512 t;
+    u512_add3(&t, &fp_p, &u512_1);
+    u512_div_64(&t, &t, d);
+    fp_enc(x, &t);
+}
+
+/* the exponents and constants only depend on p, computed once */
+static u512 root_e[8], sqrt_e;  /* x^(1/l) for l = 3, 5, 7, x^(1/2) */
+static u512 cofactor[8];        /* (p+1)/l */
+static fp half, third;
+
+__attribute__((constructor))
+static void radical_init(void)
+{
+    for (uint64_t l = 3; l <= 7; l += 2) {
+        root_exponent(&root_e[l], l);
+        u512_add3(&cofactor[l], &fp_p, &u512_1);
+        u512_div_64(&cofactor[l], &cofactor[l], l);
+    }
+    u512_add3(&sqrt_e, &fp_p, &u512_1);   /* (p+1)/4 */
+    u512_div_64(&sqrt_e, &sqrt_e, 4);
+    fp_inv_small(&half, 2);
+    fp_inv_small(&third, 3);
+}
+
+/* square root of a square, x^((p+1)/4) */
+static void fp_sqrt(fp *x)
+{
+    fp_pow(x, &sqrt_e);
+}
+
+/* y^2 + a1 xy + a3 y = x^3 + a2 x^2 for a point T of order l on the
+ * Montgomery curve with coefficient A: T goes to (0, 0) with horizontal
+ * tangent. */
+static void tate_from_montgomery(fp *a1, fp *a2, fp *a3, fp const *A, proj const *T)
+{
+    fp x = T->z, y, t, lam;
+
+    fp_inv(&x);
+    fp_mul2(&x, &T->x);
+
+    fp_sq2(&y, &x);                 // y^2 = x^3 + A x^2 + x
+    fp_mul3(&t, A, &x);
+    fp_add2(&y, &t);
+    fp_add2(&y, &fp_1);
+    fp_mul2(&y, &x);
+    fp_sqrt(&y);
+
+    fp_add3(&lam, &y, &y);          // lam = (3 x^2 + 2 A x + 1) / 2y
+    fp_inv(&lam);
+    fp_sq2(&t, &x);
+    fp_add3(a1, &t, &t);
+    fp_add2(&t, a1);
+    fp_mul3(a2, A, &x);
+    fp_add2(a2, a2);
+    fp_add2(&t, a2);
+    fp_add2(&t, &fp_1);
+    fp_mul2(&lam, &t);
+
+    fp_add3(a1, &lam, &lam);        // a1 = 2 lam, a3 = 2 y
+    fp_add3(a3, &y, &y);
+    fp_add3(a2, &x, &x);            // a2 = A + 3 x - lam^2
+    fp_add2(a2, &x);
+    fp_add2(a2, A);
+    fp_sq2(&t, &lam);
+    fp_sub2(a2, &t);
+}
+
+/* the Montgomery coefficient of y^2 + a1 xy + a3 y = x^3 + a2 x^2: the */
+/* right-hand side of y^2 = x^3 + w2 x^2 + w4 x + w6 after completing the */
+/* square has a single root x0 in fp (Cardano), then */
+/* A = (3 x0 + w2) / s for the square s with s^2 = f'(x0). */
+static void montgomery_from_tate(fp *A, fp const *a1, fp const *a2, fp const *a3)
+{
+    fp w2, w4, w6, t, u, v, P, Q, D, x0;
+
+    fp_sq2(&t, a1);                 // w2 = a2 + a1^2 / 4
+    fp_mul2(&t, &half);
+    fp_mul2(&t, &half);
+    fp_add3(&w2, a2, &t);
+    fp_mul3(&w4, a1, a3);           // w4 = a1 a3 / 2
+    fp_mul2(&w4, &half);
+    fp_sq2(&w6, a3);                // w6 = a3^2 / 4
+    fp_mul2(&w6, &half);
+    fp_mul2(&w6, &half);
+
+    fp_mul3(&t, &w2, &third);       // x = z - w2/3 gives z^3 + P z + Q
+    fp_mul3(&P, &t, &w2);
+    fp_sub3(&P, &w4, &P);           // P = w4 - w2^2/3
+    fp_mul3(&Q, &t, &w4);
+    fp_sub3(&Q, &w6, &Q);
+    fp_sq2(&u, &t);
+    fp_mul2(&u, &t);
+    fp_add2(&Q, &u);
+    fp_add2(&Q, &u);                // Q = 2 w2^3/27 - w2 w4/3 + w6
+
+    fp_mul3(&D, &Q, &half);         // D = (Q/2)^2 + (P/3)^3, a square
+    fp_sq1(&D);
+    fp_mul3(&u, &P, &third);
+    fp_sq2(&v, &u);
+    fp_mul2(&v, &u);
+    fp_add2(&D, &v);
+    fp_sqrt(&D);
+
+    fp_mul3(&v, &Q, &half);
+    fp_sub3(&u, &D, &v);            // z = cbrt(-Q/2 + sqrt D) + cbrt(-Q/2 - sqrt D)
+    fp_sub3(&v, &fp_0, &v);
+    fp_sub2(&v, &D);
+    fp_pow(&u, &root_e[3]);
+    fp_pow(&v, &root_e[3]);
+    fp_add3(&x0, &u, &v);
+    fp_sub2(&x0, &t);
+
+    fp_add3(&u, &x0, &x0);          // s^2 = 3 x0^2 + 2 w2 x0 + w4
+    fp_add2(&u, &x0);
+    fp_add2(&u, &w2);
+    fp_add2(&u, &w2);
+    fp_mul2(&u, &x0);
+    fp_add2(&u, &w4);
+    fp_sqrt(&u);
+    fp_sub3(&v, &fp_0, &u);
+    fp_cswap(&u, &v, !fp_issquare(&u));
+
+    fp_add3(A, &x0, &x0);           // A = (3 x0 + w2) / s
+    fp_add2(A, &x0);
+    fp_add2(A, &w2);
+    fp_inv(&u);
+    fp_mul2(A, &u);
+}
+
+/* l = 3: y^2 + a1 xy + a3 y = x^3; alpha = cbrt(-a3), */
+/* a1' = a1 - 6 alpha, a3' = 3 a1 alpha^2 - a1^2 alpha + 9 a3 */
+static void step3(fp *a1, fp *a3, u512 const *e)
+{
+    fp alpha, t, u;
+
+    fp_sub3(&alpha, &fp_0, a3);
+    fp_pow(&alpha, e);
+
+    fp_mul3(&t, a1, &alpha);        // alpha (3 a1 alpha - a1^2)
+    fp_add3(&u, &t, &t);
+    fp_add2(&u, &t);
+    fp_sq2(&t, a1);
+    fp_sub2(&u, &t);
+    fp_mul2(&u, &alpha);
+    fp_add3(&t, a3, a3);            // + 9 a3
+    fp_add2(&t, &t);
+    fp_add2(&t, &t);
+    fp_add2(&t, a3);
+    fp_add3(a3, &u, &t);
+
+    fp_add3(&t, &alpha, &alpha);
+    fp_add2(&t, &alpha);
+    fp_add2(&t, &t);
+    fp_sub2(a1, &t);
+}
+
+/* l = 5: Tate normal form y^2 + (1-b) xy - by = x^3 - bx^2 with b = n/d; */
+/* alpha = b^(1/5) = (n d^4)^(1/5) / d = r / d and */
+/* b' = alpha (alpha^4 + 3 alpha^3 + 4 alpha^2 + 2 alpha + 1) */
+/*          / (alpha^4 - 2 alpha^3 + 4 alpha^2 - 3 alpha + 1) */
+static void step5(fp *n, fp *d, u512 const *e)
+{
+    fp r, d2, r2, rd, t, u;
+
+    fp_sq2(&d2, d);
+    fp_sq2(&r, &d2);
+    fp_mul2(&r, n);
+    fp_pow(&r, e);
+
+    fp_sq2(&r2, &r);
+    fp_mul3(&rd, &r, d);
+
+    fp_sq2(&t, &r2);                // r^4 + 4 r^2 d^2 + d^4
+    fp_mul3(&u, &r2, &d2);
+    fp_add2(&u, &u);
+    fp_add2(&u, &u);
+    fp_add2(&t, &u);
+    fp_sq2(&u, &d2);
+    fp_add2(&t, &u);
+
+    fp_mul2(&r2, &rd);              // r^3 d and r d^3
+    fp_mul2(&rd, &d2);
+
+    fp_add3(&u, &r2, &r2);          // n' = r (t + 3 r^3 d + 2 r d^3)
+    fp_add2(&u, &r2);
+    fp_add3(n, &t, &u);
+    fp_add3(&u, &rd, &rd);
+    fp_add2(n, &u);
+    fp_mul2(n, &r);
+
+    fp_add3(&u, &r2, &r2);          // d' = d (t - 2 r^3 d - 3 r d^3)
+    fp_sub2(&t, &u);
+    fp_add3(&u, &rd, &rd);
+    fp_add2(&u, &rd);
+    fp_sub2(&t, &u);
+    fp_mul2(d, &t);
+}
+
+/* x = c y for a small constant c */
+static void times(fp *x, uint64_t c, fp const *y)
+{
+    fp t = *y;
+    *x = fp_0;
+    for (; c; c >>= 1) {
+        if (c & 1)
+            fp_add2(x, &t);
+        fp_add2(&t, &t);
+    }
+}
+
+/* x = a u + b v for small constants a, b */
+static void lin(fp *x, int64_t a, fp const *u, int64_t b, fp const *v)
+{
+    fp t;
+    times(x, a < 0 ? -a : a, u);
+    if (a < 0)
+        fp_sub3(x, &fp_0, x);
+    times(&t, b < 0 ? -b : b, v);
+    if (b < 0)
+        fp_sub2(x, &t);
+    else
+        fp_add2(x, &t);
+}
+
+/* l = 7: Tate normal form y^2 + (1-c) xy - by = x^3 - bx^2 with */
+/* b = d^3 - d^2, c = d^2 - d, where (0, 0) has order 7 (Kubert). the */
+/* next kernel point is the T of order 7 on the codomain of Velu's */
+/* isogeny for <(0, 0)> with dual(T) = +-(0, 0); moving T to (0, 0) as */
+/* in tate_from_montgomery() gives d' in F_p(d, alpha) for the radical */
+/* alpha^7 = c^3 / b = d (d-1)^2, of degree 4 over the common */
+/* denominator. with d = n/m, alpha = (n s^2 m^4)^(1/7) / m = r / m */
+/* for s = m - n, and d' = n'/m' with */
+/* n' = s m (7 n m^2 + r m (4m + 9n) + r^2 (3m - 2n)) */
+/*          + r^3 (m (4m - 5n) + r (6n - 2m)) */
+/* m' = s m^2 (2m (n + 2m) + r (8n - 5m) + 14 r^2) */
+/*          + r^3 (m (9n - 10m) + r (2n + 11m)) */
+/* the chains agree with the Velu ones of action_vartime(), make kat_radical */
+static void step7(fp *n, fp *m, u512 const *e)
+{
+    fp s, m2, r, r2, r3, t, u, v, w;
+
+    fp_sub3(&s, m, n);
+    fp_sq2(&m2, m);
+    fp_sq2(&r, &m2);
+    fp_mul2(&r, n);
+    fp_sq2(&t, &s);
+    fp_mul2(&r, &t);
+    fp_pow(&r, e);
+    fp_sq2(&r2, &r);
+    fp_mul3(&r3, &r2, &r);
+
+    lin(&t, 9, n, -10, m);          // r^3 (m (9n - 10m) + r (2n + 11m))
+    fp_mul2(&t, m);
+    lin(&u, 2, n, 11, m);
+    fp_mul2(&u, &r);
+    fp_add2(&t, &u);
+    fp_mul2(&t, &r3);
+    lin(&u, 1, n, 2, m);            // s m^2 (2m (n + 2m) + r (8n - 5m) + 14 r^2)
+    fp_mul2(&u, m);
+    fp_add2(&u, &u);
+    lin(&v, 8, n, -5, m);
+    fp_mul2(&v, &r);
+    fp_add2(&u, &v);
+    times(&v, 14, &r2);
+    fp_add2(&u, &v);
+    fp_mul2(&u, &s);
+    fp_mul2(&u, &m2);
+    fp_add3(&w, &t, &u);
+
+    lin(&t, -5, n, 4, m);           // r^3 (m (4m - 5n) + r (6n - 2m))
+    fp_mul2(&t, m);
+    lin(&u, 6, n, -2, m);
+    fp_mul2(&u, &r);
+    fp_add2(&t, &u);
+    fp_mul2(&t, &r3);
+    times(&u, 7, n);                // s m (7 n m^2 + r m (4m + 9n) + r^2 (3m - 2n))
+    fp_mul2(&u, &m2);
+    lin(&v, 9, n, 4, m);
+    fp_mul2(&v, m);
+    fp_mul2(&v, &r);
+    fp_add2(&u, &v);
+    lin(&v, -2, n, 3, m);
+    fp_mul2(&v, &r2);
+    fp_add2(&u, &v);
+    fp_mul2(&u, &s);
+    fp_mul2(&u, m);
+    fp_add3(n, &t, &u);
+    *m = w;
+}
+
+void radical_isog(fp *A, uint64_t l, int8_t e, unsigned bound)
+{
+    assert (radical_supported(l));
+
+    fp a1, a2, a3, b1, b3, minus_A;
+    proj P, Pd, T;
+    curve E;
+    u512 const *root = &root_e[l];
+
+    // CONSTANT TIME : the steps go along points of order l on the curve,
+    // which is the direction of negative exponents in action(); positive
+    // ones are the same on the twist, with coefficient -A.
+    uint8_t neg = (uint8_t) e >> 7, pos = (uint8_t) -e >> 7;
+    int8_t abs_e = (e ^ -neg) + neg;
+
+    fp_sub3(&minus_A, &fp_0, A);
+    fp_cswap(A, &minus_A, pos);
+
+    curve_set(&E, &(proj) { *A, fp_1 });
+    do {  //depends only on randomness
+        if (memcmp(A, &fp_0, sizeof(fp))) {
+            elligator(&P, &Pd, &E.A);
+        } else {
+            fp_enc(&P.x, &p_order); // point of full order on E_a with a=0
+            P.z = fp_1;
+        }
+        xMUL(&T, &E, &P, &cofactor[l]);
+    } while (!memcmp(&T.z, &fp_0, sizeof(fp)));
+
+    tate_from_montgomery(&a1, &a2, &a3, A, &T);
+
+    if (l == 3) {
+        for (unsigned i = 0; i < bound; ++i) {
+            b1 = a1;
+            b3 = a3;
+            step3(&b1, &b3, root);
+            bool real = ((int64_t) i - abs_e) >> 63 & 1;
+            fp_cswap(&a1, &b1, real);
+            fp_cswap(&a3, &b3, real);
+        }
+        a2 = fp_0;
+    } else if (l == 5) {
+        // b = -a2^3 / a3^2, and a1 = 1 - b
+        fp_sq2(&b1, &a2);
+        fp_mul2(&b1, &a2);
+        fp_sub3(&b1, &fp_0, &b1);
+        fp_sq2(&b3, &a3);
+        for (unsigned i = 0; i < bound; ++i) {
+            fp n = b1, d = b3;
+            step5(&n, &d, root);
+            bool real = ((int64_t) i - abs_e) >> 63 & 1;
+            fp_cswap(&b1, &n, real);
+            fp_cswap(&b3, &d, real);
+        }
+        fp_inv(&b3);
+        fp_mul2(&b1, &b3);
+        fp_sub3(&a2, &fp_0, &b1);
+        fp_sub3(&a1, &fp_1, &b1);
+        a3 = a2;
+    } else {
+        // d = b / c for b = -a2^3 / a3^2 and c = 1 - a1 a2 / a3
+        fp_sq2(&b1, &a2);
+        fp_mul2(&b1, &a2);
+        fp_sub3(&b1, &fp_0, &b1);
+        fp_mul3(&b3, &a1, &a2);
+        fp_sub3(&b3, &a3, &b3);
+        fp_mul2(&b3, &a3);
+        for (unsigned i = 0; i < bound; ++i) {
+            fp n = b1, m = b3;
+            step7(&n, &m, root);
+            bool real = ((int64_t) i - abs_e) >> 63 & 1;
+            fp_cswap(&b1, &n, real);
+            fp_cswap(&b3, &m, real);
+        }
+        fp_inv(&b3);                // c = d^2 - d, b = d c
+        fp_mul2(&b1, &b3);
+        fp_sub3(&b3, &b1, &fp_1);
+        fp_mul2(&b3, &b1);
+        fp_mul2(&b1, &b3);
+        fp_sub3(&a1, &fp_1, &b3);
+        fp_sub3(&a2, &fp_0, &b1);
+        a3 = a2;
+    }
+
+    montgomery_from_tate(A, &a1, &a2, &a3);
+
+    fp_sub3(&minus_A, &fp_0, A);
+    fp_cswap(A, &minus_A, pos);
+}
@@ -0,0 +1,18 @@
+#ifndef RADICAL_H
+#define RADICAL_H
+
+#include "u512.h"
+#include "fp.h"
+
+/* radical isogenies: chains of l-isogenies for l in {3, 5, 7}, one l-th
+ * root per step on a Tate normal form instead of a kernel point per step.
+ * only a single point of order l is needed to start a chain. */
+
+bool radical_supported(uint64_t l);
+
+/* replaces the Montgomery coefficient A by the result of e isogenies of
+ * degree l, in the direction of action() for the sign of e; always does
+ * bound steps, constant-time in e for |e| <= bound. */
+void radical_isog(fp *A, uint64_t l, int8_t e, unsigned bound);
+
+#endif
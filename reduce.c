@@ -0,0 +1,123 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "csidh.h"
+#include "lattice.h"
+#include "rng.h"
+
+/* reduces random exponent vectors modulo the relation lattice loaded from
+ * basis.txt, see lattice.h for the format. first checks that every row of
+ * the basis is a relation, then reports the L1 and max norms before and
+ * after, the time per reduction and, per prime, the largest |e_i| seen after
+ * reduction: a candidate max[] for constant-time evaluation of reduced
+ * vectors. the first few vectors are also evaluated with action_vartime()
+ * both ways; the curves have to be equal.
+ * usage: ./reduce [-n samples] [-m bound] [-c checks] basis.txt */
+
+static lattice L;
+
+static double ms(clock_t t0, clock_t t1) { return 1000. * (t1 - t0) / CLOCKS_PER_SEC; }
+
+static int usage(char const *name) {
+	fprintf(stderr, "usage: %s [-n samples] [-m bound] [-c checks] basis.txt\n", name);
+	return 1;
+}
+
+int main(int argc, char **argv) {
+	unsigned long samples = 1000, checks = 4;
+	long bound = 100;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "n:m:c:")) != -1) {
+		switch (opt) {
+		case 'n': samples = strtoul(optarg, NULL, 10); break;
+		case 'm': bound = strtol(optarg, NULL, 10); break;
+		case 'c': checks = strtoul(optarg, NULL, 10); break;
+		default:
+			return usage(argv[0]);
+		}
+	}
+	if (optind + 1 != argc || !samples || bound < 1 || bound > INT32_MAX / 2)
+		return usage(argv[0]);
+
+	if (!lattice_load(&L, argv[optind])) {
+		fprintf(stderr, "%s: not a basis for these %u primes\n", argv[optind], num_primes);
+		return 1;
+	}
+	size_t row;
+	clock_t t0 = clock();
+	if (!lattice_verify(&L, &row)) {
+		fprintf(stderr, "%s: row %zu is not a relation\n", argv[optind], row);
+		return 1;
+	}
+	printf("%u relations verified in %.0f ms\n", num_primes, ms(t0, clock()));
+
+	int largest[num_primes] = { 0 };
+	double l1_in = 0, l1_out = 0, t_reduce = 0, t_in = 0, t_out = 0;
+	long max_in = 0, max_out = 0;
+
+	for (unsigned long k = 0; k < samples; ++k) {
+		uint32_t r[num_primes];
+		int32_t e[num_primes];
+		private_key red;
+
+		randombytes(r, sizeof(r));
+		for (size_t i = 0; i < num_primes; ++i) {
+			e[i] = (long) (r[i] % (2 * bound + 1)) - bound;
+			l1_in += labs(e[i]);
+			if (labs(e[i]) > max_in)
+				max_in = labs(e[i]);
+		}
+
+		t0 = clock();
+		bool ok = lattice_reduce(&red, &L, e);
+		t_reduce += ms(t0, clock());
+		if (!ok) {
+			fprintf(stderr, "sample %lu does not reduce to a private_key\n", k);
+			return 1;
+		}
+		for (size_t i = 0; i < num_primes; ++i) {
+			int a = abs(red.e[i]);
+			l1_out += a;
+			if (a > max_out)
+				max_out = a;
+			if (a > largest[i])
+				largest[i] = a;
+		}
+
+		if (k < checks && bound <= INT8_MAX) {
+			private_key in;
+			public_key a, b;
+			for (size_t i = 0; i < num_primes; ++i)
+				in.e[i] = e[i];
+			t0 = clock();
+			action_vartime(&a, &base, &in);
+			clock_t t1 = clock();
+			action_vartime(&b, &base, &red);
+			t_in += ms(t0, t1);
+			t_out += ms(t1, clock());
+			if (memcmp(&a, &b, sizeof(a))) {
+				fprintf(stderr, "sample %lu: the reduced vector acts differently\n", k);
+				return 1;
+			}
+		}
+	}
+
+	printf("%lu vectors in [-%ld, %ld]^%u\n", samples, bound, bound, num_primes);
+	printf("  L1 norm   %10.1f -> %.1f\n", l1_in / samples, l1_out / samples);
+	printf("  max norm  %10ld -> %ld\n", max_in, max_out);
+	printf("  reduce    %10.3f ms\n", t_reduce / samples);
+	if (checks && bound <= INT8_MAX) {
+		unsigned long n = checks < samples ? checks : samples;
+		printf("  action_vartime %.1f ms -> %.1f ms, same curves for %lu vectors\n",
+				t_in / n, t_out / n, n);
+	}
+	printf("largest |e_i| after reduction, in the order of primes[]:\n ");
+	for (size_t i = 0; i < num_primes; ++i)
+		printf(" %d", largest[i]);
+	printf("\n");
+	return 0;
+}
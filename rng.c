@@ -2,17 +2,112 @@
 #include "rng.h"
 
 #include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
 #include <unistd.h>
 #include <fcntl.h>
 
-void randombytes(void *x, size_t l)
+static void urandom(void *x, size_t l)
 {
-    static int fd = -1;
+    static _Atomic int fd = -1;
+    int f = atomic_load(&fd), expected = -1;
     ssize_t n;
-    if (fd < 0 && 0 > (fd = open("/dev/urandom", O_RDONLY)))
-        exit(1);
+    if (f < 0) {
+        /* several threads may get here at once; keep only one descriptor. */
+        if (0 > (f = open("/dev/urandom", O_RDONLY)))
+            exit(1);
+        if (!atomic_compare_exchange_strong(&fd, &expected, f)) {
+            close(f);
+            f = expected;
+        }
+    }
     for (size_t i = 0; i < l; i += n)
-        if (0 >= (n = read(fd, (char *) x + i, l - i)))
+        if (0 >= (n = read(f, (char *) x + i, l - i)))
             exit(2);
 }
 
+static randombytes_fn source = NULL;
+static void *source_ctx = NULL;
+
+void randombytes_set(randombytes_fn fn, void *ctx)
+{
+    source = fn;
+    source_ctx = ctx;
+}
+
+void randombytes(void *x, size_t l)
+{
+    if (source)
+        source(source_ctx, x, l);
+    else
+        urandom(x, l);
+}
+
+
+#define ROTL(x, n) ((x) << (n) | (x) >> (32 - (n)))
+#define QR(a, b, c, d) \
+    a += b; d ^= a; d = ROTL(d, 16); \
+    c += d; b ^= c; b = ROTL(b, 12); \
+    a += b; d ^= a; d = ROTL(d, 8); \
+    c += d; b ^= c; b = ROTL(b, 7);
+
+/* ChaCha20 block with a 64-bit counter and zero nonce */
+static void chacha20_block(uint8_t out[64], uint32_t const key[8], uint64_t counter)
+{
+    uint32_t in[16] = {
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+        key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+        (uint32_t) counter, (uint32_t) (counter >> 32), 0, 0,
+    };
+    uint32_t x[16];
+    memcpy(x, in, sizeof(x));
+
+    for (int i = 0; i < 10; ++i) {
+        QR(x[0], x[4], x[8], x[12]);
+        QR(x[1], x[5], x[9], x[13]);
+        QR(x[2], x[6], x[10], x[14]);
+        QR(x[3], x[7], x[11], x[15]);
+        QR(x[0], x[5], x[10], x[15]);
+        QR(x[1], x[6], x[11], x[12]);
+        QR(x[2], x[7], x[8], x[13]);
+        QR(x[3], x[4], x[9], x[14]);
+    }
+
+    for (int i = 0; i < 16; ++i) {
+        uint32_t v = x[i] + in[i];
+        out[4 * i + 0] = v;
+        out[4 * i + 1] = v >> 8;
+        out[4 * i + 2] = v >> 16;
+        out[4 * i + 3] = v >> 24;
+    }
+}
+
+void rng_det_init(rng_det *r, uint8_t const seed[32])
+{
+    for (int i = 0; i < 8; ++i)
+        r->key[i] = (uint32_t) seed[4 * i] | (uint32_t) seed[4 * i + 1] << 8
+            | (uint32_t) seed[4 * i + 2] << 16 | (uint32_t) seed[4 * i + 3] << 24;
+    r->counter = 0;
+    r->pos = sizeof(r->buf);
+}
+
+void rng_det_randombytes(void *ctx, void *x, size_t l)
+{
+    rng_det *r = ctx;
+    uint8_t *out = x;
+
+    while (l) {
+        if (r->pos == sizeof(r->buf)) {
+            chacha20_block(r->buf, r->key, r->counter++);
+            r->pos = 0;
+        }
+        size_t n = sizeof(r->buf) - r->pos;
+        if (n > l)
+            n = l;
+        memcpy(out, r->buf + r->pos, n);
+        r->pos += n;
+        out += n;
+        l -= n;
+    }
+}
+
@@ -2,7 +2,26 @@
 #define RNG_H
 
 #include <stdlib.h>
+#include <stdint.h>
 
 void randombytes(void *x, size_t l);
 
+/* randombytes() draws from /dev/urandom unless another source is plugged in. */
+/* the source is global; set it before any thread starts using randombytes(). */
+typedef void (*randombytes_fn)(void *ctx, void *x, size_t l);
+
+void randombytes_set(randombytes_fn fn, void *ctx); /* NULL restores /dev/urandom */
+
+/* deterministic source for reproducible runs and known-answer tests: */
+/* the ChaCha20 keystream under the seed. not for production keys. */
+typedef struct rng_det {
+    uint32_t key[8];
+    uint64_t counter;
+    uint8_t buf[64];
+    size_t pos;
+} rng_det;
+
+void rng_det_init(rng_det *r, uint8_t const seed[32]);
+void rng_det_randombytes(void *ctx, void *x, size_t l);
+
 #endif
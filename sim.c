@@ -0,0 +1,381 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "u512.h"
+#include "fp.h"
+#include "mont.h"
+#include "csidh.h"
+#include "rng.h"
+#include "cycle.h"
+
+/* cost model of action(): replays its control flow without any curve
+ * arithmetic. the field operations of every building block (xDBLADD,
+ * elligator, xISOG and lastxISOG per prime) are counted once on the real
+ * code, then weighted by the measured cycles per field operation. the
+ * only randomness of action() is whether a kernel point is zero, which
+ * happens with probability 1/l for random points, so a simulated action
+ * takes microseconds. non-field work (scalar products, lookups, swaps)
+ * is not modelled; -m measures real action() calls for comparison.
+ * -w sets the cycles of mul,sq,add,inv,issquare,mul4,mul8 instead of
+ * measuring them; mul4 and mul8 are one call of the four- or eight-lane
+ * kernel, calls with up to two lanes count as that many single products.
+ * usage: ./sim [-n runs] [-b batches] [-y my] [-e max | -E e1,e2,...] [-s]
+ *              [-w mul,sq,add,inv,issquare,mul4,mul8] [-m calls] */
+
+static uint8_t num_batches = default_num_batches;
+static uint8_t my = default_my;
+static int8_t max[num_primes];
+static bool shared = false; /* from a random curve instead of E_0 */
+
+/* cycles per field operation */
+static struct { double mul, sq, add, inv, issquare, mul4, mul8; } w;
+
+/* cycles of the building blocks */
+static double c_xdbladd, c_xdbladd2, c_elligator, c_normalize;
+static double c_xisog[num_primes], c_lastxisog[num_primes];
+static double log2_l[num_primes];
+
+static double cost(opcount_ops const *o) {
+	return o->mul * w.mul + o->sq * w.sq + o->add * w.add + o->inv * w.inv + o->issquare * w.issquare
+		+ o->mul4 * w.mul4 + o->mul8 * w.mul8;
+}
+
+static opcount_ops since(opcount_ops const *before) {
+	return (opcount_ops) {
+		.mul = opcount.mul - before->mul, .sq = opcount.sq - before->sq,
+		.add = opcount.add - before->add, .inv = opcount.inv - before->inv,
+		.issquare = opcount.issquare - before->issquare, .mul4 = opcount.mul4 - before->mul4,
+		.mul8 = opcount.mul8 - before->mul8,
+	};
+}
+
+static int cmp_double(void const *a, void const *b) {
+	double x = *(double const *) a, y = *(double const *) b;
+	return (x > y) - (x < y);
+}
+
+/* median cycles of one call, over samples of reps calls */
+#define MEASURE(reps, stmt) ({ \
+	double t_[101]; \
+	for (size_t s_ = 0; s_ < 101; ++s_) { \
+		ticks t0_ = getticks(); \
+		for (size_t r_ = 0; r_ < (reps); ++r_) { stmt; } \
+		t_[s_] = elapsed(getticks(), t0_) / (reps); \
+	} \
+	qsort(t_, 101, sizeof(*t_), cmp_double); \
+	t_[50]; })
+
+static void calibrate(void) {
+	fp x, y, v[8];
+	fp *vp[8] = { &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7] };
+	fp_random(&x);
+	fp_random(&y);
+	for (size_t i = 0; i < 8; ++i)
+		fp_random(&v[i]);
+	if (!w.mul) {
+		MEASURE(10000, fp_mul2(&x, &y)); /* warm-up */
+		w.mul = MEASURE(10000, fp_mul2(&x, &y));
+		w.sq = MEASURE(10000, fp_sq1(&x));
+		w.add = MEASURE(10000, fp_add2(&x, &y));
+		w.inv = MEASURE(20, fp_inv(&x));
+		w.issquare = MEASURE(20, y.x.c[0] ^= fp_issquare(&x));
+		w.mul4 = MEASURE(10000, fp_mul4(vp, (fp const *const *) vp, (fp const *const *) vp, 4));
+		w.mul8 = MEASURE(10000, fp_mul8(vp, (fp const *const *) vp, (fp const *const *) vp, 8));
+	}
+
+	private_key priv;
+	public_key pub;
+	curve E;
+	proj P, Pd, K;
+	opcount_ops before, ops;
+
+	csidh_private(&priv, default_max);
+	action(&pub, &base, &priv, default_num_batches, default_max, default_num_isogenies, default_my);
+	curve_set(&E, &(proj) { pub.A, fp_1 });
+
+	before = opcount;
+	elligator(&P, &Pd, &E.A);
+	ops = since(&before);
+	c_elligator = cost(&ops);
+
+	before = opcount;
+	xDBLADD(&P, &Pd, &P, &Pd, &K, &E.A24);
+	ops = since(&before);
+	c_xdbladd = cost(&ops);
+
+	/* a step of the two-lane ladder of xMUL2, whose products go through
+	 * fp_mul8: the difference between 64- and 32-bit scalars */
+	u512 k32, k64;
+	u512_set(&k32, 0xffffffff);
+	u512_set(&k64, UINT64_MAX);
+	before = opcount;
+	xMUL2(&P, &Pd, &E, &P, &Pd, &k32);
+	ops = since(&before);
+	c_xdbladd2 = -cost(&ops);
+	before = opcount;
+	xMUL2(&P, &Pd, &E, &P, &Pd, &k64);
+	ops = since(&before);
+	c_xdbladd2 = (c_xdbladd2 + cost(&ops)) / 32;
+
+	c_normalize = w.inv + w.mul;
+
+	/* the isogenies cost the same for any kernel point and curve */
+	for (size_t i = 0; i < num_primes; ++i) {
+		curve F = E;
+		elligator(&P, &Pd, &F.A);
+		elligator(&K, &Pd, &F.A);
+		before = opcount;
+		xISOG(&F, &P, &Pd, &K, primes[i], 0);
+		ops = since(&before);
+		c_xisog[i] = cost(&ops);
+		F = E;
+		before = opcount;
+		lastxISOG(&F, &K, primes[i], 0);
+		ops = since(&before);
+		c_lastxisog[i] = cost(&ops);
+		log2_l[i] = log2(primes[i]);
+	}
+}
+
+/* the Montgomery ladder does one xDBLADD per bit of the scalar */
+static double ladder(double log2_k) {
+	return (floor(log2_k) + 1) * c_xdbladd;
+}
+
+/* the same for the two ladders of xMUL2, which run as one */
+static double ladder2(double log2_k) {
+	return (floor(log2_k) + 1) * c_xdbladd2;
+}
+
+/* uniform in [0, 1) */
+static uint64_t rng_state;
+static double uniform(void) {
+	rng_state ^= rng_state << 13;
+	rng_state ^= rng_state >> 7;
+	rng_state ^= rng_state << 17;
+	return (rng_state >> 11) * 0x1p-53;
+}
+
+typedef struct run {
+	double cycles, phase[opcount_num_phases];
+	unsigned rounds;
+} run;
+
+/* one action(), following action_init() and action_step() */
+static void simulate(run *r, unsigned int num_isogenies) {
+	bool finished[num_primes] = { 0 };
+	int8_t counter[num_primes];
+	unsigned int isog_counter = 0;
+	uint8_t nb = num_batches, m = 0, count = 0;
+
+	memcpy(counter, max, sizeof(counter));
+	memset(r, 0, sizeof(*r));
+
+	while (isog_counter < num_isogenies) {
+		m = (m + 1) % nb;
+		if (count == my * nb) {
+			m = 0;
+			nb = 1;
+		}
+		size_t last_iso = m + (num_primes - 1 - m) / nb * nb;
+
+		//the fixed-base round and points of full order never miss a prime
+		bool from_base = !shared && count == 0 && nb == default_num_batches;
+		bool full_order = !shared && count == 0;
+
+		if (!from_base) {
+			double log2_k = 2;
+			for (size_t i = 0; i < num_primes; ++i)
+				if (i % nb != m || finished[i])
+					log2_k += log2_l[i];
+			r->phase[OPCOUNT_ELLIGATOR] += full_order ? 0 : c_elligator;
+			r->phase[OPCOUNT_XMUL] += ladder2(log2_k);
+		}
+
+		for (size_t i = m; i < num_primes; i += nb) {
+			if (finished[i])
+				continue;
+
+			if (!from_base || i != m) {
+				double log2_cof = 0;
+				for (size_t j = i + nb; j < num_primes; j += nb)
+					if (!finished[j])
+						log2_cof += log2_l[j];
+				r->phase[OPCOUNT_COFACTOR] += ladder(log2_cof) + ladder(log2_l[i]);
+			}
+
+			if (full_order || uniform() * primes[i] >= 1) {
+				if (i == last_iso)
+					r->phase[OPCOUNT_LASTXISOG] += c_lastxisog[i];
+				else
+					r->phase[OPCOUNT_XISOG] += c_xisog[i];
+				--counter[i];
+				++isog_counter;
+			}
+
+			if (counter[i] == 0)
+				finished[i] = true;
+		}
+		++count;
+	}
+	r->phase[OPCOUNT_NORMALIZE] = c_normalize;
+	r->rounds = count;
+
+	for (size_t k = 0; k < opcount_num_phases; ++k)
+		r->cycles += r->phase[k];
+}
+
+/* mean cycles and rounds of real action() calls */
+static double measure_action(unsigned long calls, unsigned int num_isogenies, double *rounds) {
+	private_key priv;
+	public_key in = base, out;
+	action_state st;
+	double total = 0;
+
+	if (shared) {
+		csidh_private(&priv, default_max);
+		action(&in, &base, &priv, default_num_batches, default_max, default_num_isogenies, default_my);
+	}
+	*rounds = 0;
+	for (unsigned long c = 0; c < calls; ++c) {
+		csidh_private(&priv, max);
+		ticks t0 = getticks();
+		action_init(&st, &in, &priv, num_batches, max, num_isogenies, my);
+		while (!action_step(&st, UINT_MAX));
+		*rounds += (double) st.count / calls;
+		action_finish(&out, &st);
+		total += elapsed(getticks(), t0);
+	}
+	return total / calls;
+}
+
+/* ticks per millisecond, from the wall clock */
+static double ticks_per_ms(void) {
+	struct timespec a, b;
+	clock_gettime(CLOCK_MONOTONIC, &a);
+	ticks t0 = getticks();
+	do
+		clock_gettime(CLOCK_MONOTONIC, &b);
+	while ((b.tv_sec - a.tv_sec) * 1e3 + (b.tv_nsec - a.tv_nsec) / 1e6 < 50);
+	double ms = (b.tv_sec - a.tv_sec) * 1e3 + (b.tv_nsec - a.tv_nsec) / 1e6;
+	return elapsed(getticks(), t0) / ms;
+}
+
+static bool parse_max(char const *s) {
+	for (size_t i = 0; i < num_primes; ++i) {
+		char *end;
+		long v = strtol(s, &end, 10);
+		if (end == s || v < 0 || v > 127)
+			return false;
+		max[i] = v;
+		s = end + (*end == ',');
+	}
+	return !*s;
+}
+
+int main(int argc, char **argv) {
+	unsigned long runs = 10000, calls = 0;
+	int opt;
+
+	memcpy(max, default_max, sizeof(max));
+
+	while ((opt = getopt(argc, argv, "n:b:y:e:E:sw:m:")) != -1) {
+		switch (opt) {
+		case 'n': runs = strtoul(optarg, NULL, 10); break;
+		case 'b': num_batches = atoi(optarg); break;
+		case 'y': my = atoi(optarg); break;
+		case 'e': memset(max, atoi(optarg), sizeof(max)); break;
+		case 'E':
+			if (!parse_max(optarg)) {
+				fprintf(stderr, "-E needs %d comma-separated exponents\n", num_primes);
+				return 1;
+			}
+			break;
+		case 's': shared = true; break;
+		case 'w':
+			if (sscanf(optarg, "%lf,%lf,%lf,%lf,%lf,%lf,%lf", &w.mul, &w.sq, &w.add, &w.inv, &w.issquare, &w.mul4, &w.mul8) != 7) {
+				fprintf(stderr, "-w needs 7 comma-separated cycle counts\n");
+				return 1;
+			}
+			break;
+		case 'm': calls = strtoul(optarg, NULL, 10); break;
+		default:
+			fprintf(stderr, "usage: %s [-n runs] [-b batches] [-y my] [-e max | -E e1,e2,...] [-s] [-w mul,sq,add,inv,issquare,mul4,mul8] [-m calls]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (!runs || !num_batches || num_batches > num_primes) {
+		fprintf(stderr, "need runs > 0 and 1 <= batches <= %d\n", num_primes);
+		return 1;
+	}
+
+	unsigned int num_isogenies = 0;
+	for (size_t i = 0; i < num_primes; ++i)
+		num_isogenies += max[i];
+
+	// calculate inverses for "elligatoring"
+	for (int i = 2; i <= 10; i++) {
+		fp_set(&invs_[i - 2], i);
+		fp_sq1(&invs_[i - 2]);
+		fp_sub2(&invs_[i - 2], &fp_1);
+		fp_inv(&invs_[i - 2]);
+	}
+
+	calibrate();
+	double per_ms = ticks_per_ms();
+	randombytes(&rng_state, sizeof(rng_state));
+	rng_state |= 1;
+
+	run *r = malloc(runs * sizeof(*r));
+	double *cycles = malloc(runs * sizeof(*cycles));
+	if (!r || !cycles)
+		return 1;
+
+	struct timespec t0, t1;
+	clock_gettime(CLOCK_MONOTONIC, &t0);
+	for (unsigned long k = 0; k < runs; ++k)
+		simulate(&r[k], num_isogenies);
+	clock_gettime(CLOCK_MONOTONIC, &t1);
+
+	double mean = 0, var = 0, rounds = 0, phase[opcount_num_phases] = { 0 };
+	for (unsigned long k = 0; k < runs; ++k) {
+		cycles[k] = r[k].cycles;
+		mean += r[k].cycles / runs;
+		rounds += (double) r[k].rounds / runs;
+		for (size_t p = 0; p < opcount_num_phases; ++p)
+			phase[p] += r[k].phase[p] / runs;
+	}
+	for (unsigned long k = 0; k < runs; ++k)
+		var += (cycles[k] - mean) * (cycles[k] - mean) / runs;
+	qsort(cycles, runs, sizeof(*cycles), cmp_double);
+
+	printf("field operations: mul %.0f, sq %.0f, add %.0f, inv %.0f, issquare %.0f, mul4 %.0f, mul8 %.0f cycles\n",
+			w.mul, w.sq, w.add, w.inv, w.issquare, w.mul4, w.mul8);
+	printf("%d batches, my = %d, %u isogenies, %s\n\n", num_batches, my, num_isogenies,
+			shared ? "from a random curve" : "from E_0");
+	printf("%lu simulated actions in %.0f ms\n", runs,
+			(t1.tv_sec - t0.tv_sec) * 1e3 + (t1.tv_nsec - t0.tv_nsec) / 1e6);
+	printf("  rounds      %12.2f\n", rounds);
+	printf("  mean        %12.0f cycles  %8.2f ms\n", mean, mean / per_ms);
+	printf("  stddev      %12.0f cycles  %8.2f ms\n", sqrt(var), sqrt(var) / per_ms);
+	printf("  median      %12.0f cycles\n", cycles[runs / 2]);
+	printf("  99%%         %12.0f cycles\n", cycles[runs * 99 / 100]);
+	for (size_t p = 0; p < opcount_num_phases; ++p)
+		printf("  %-11s %12.0f cycles  %7.1f%%\n",
+				(char const *[]) { "elligator", "xMUL", "cofactor", "xISOG", "lastxISOG", "normalize" }[p],
+				phase[p], 100 * phase[p] / mean);
+
+	if (calls) {
+		double real_rounds, real = measure_action(calls, num_isogenies, &real_rounds);
+		printf("\n%lu real actions: %.2f rounds, mean %.0f cycles, %.2f ms; model / real = %.3f\n",
+				calls, real_rounds, real, real / per_ms, mean / real);
+	}
+
+	free(r);
+	free(cycles);
+}
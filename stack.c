@@ -0,0 +1,161 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "u512.h"
+#include "fp.h"
+#include "mont.h"
+#include "csidh.h"
+#include "ctidh.h"
+#include "rng.h"
+
+/* peak stack usage per entry point: each one runs on a fresh thread
+ * whose stack is painted with a pattern beforehand; the lowest
+ * overwritten byte afterwards is the high-water mark. the usage of an
+ * empty function (thread start-up, TLS) is subtracted.
+ * exits with status 1 if an entry point takes more than its limit in
+ * csidh.h, csidh_stack_with_max for the *_with() variants and
+ * csidh_stack_max for the others.
+ * usage: ./stack */
+
+#define stack_size (1 << 20)
+#define paint 0xa5
+
+static uint8_t num_batches = default_num_batches;
+static uint8_t my = default_my;
+static unsigned int num_isogenies = default_num_isogenies;
+
+static int8_t const *max = default_max;
+
+static private_key priv, ctidh_priv;
+static public_key pub, out;
+static csidh_scratch scratch;
+static ctidh_scratch ctidh_scratch_;
+static curve E;
+static proj P, Pd, K;
+
+static void run_nothing(void) { }
+static void run_csidh_private(void) { csidh_private(&priv, max); }
+static void run_xMUL(void) { xMUL(&P, &E, &P, &(u512) { .c = { 0x1234567 } }); }
+static void run_elligator(void) { elligator(&P, &Pd, &E.A); }
+static void run_xISOG(void) { xISOG(&E, &P, &Pd, &K, primes[0], 0); }
+static void run_lastxISOG(void) { lastxISOG(&E, &K, primes[0], 0); }
+static void run_validate(void) { validate(&pub); }
+static void run_validate_batch(void) {
+	public_key in[validate_lanes];
+	bool ok[validate_lanes];
+	for (size_t i = 0; i < validate_lanes; ++i)
+		in[i] = pub;
+	validate_batch(in, ok, validate_lanes);
+}
+static void run_validate_with(void) { validate_with(&pub, &scratch.validate); }
+static void run_validate_batch_with(void) {
+	public_key in[validate_lanes];
+	bool ok[validate_lanes];
+	for (size_t i = 0; i < validate_lanes; ++i)
+		in[i] = pub;
+	validate_batch_with(in, ok, validate_lanes, &scratch.validate);
+}
+static void run_action(void) {
+	action(&out, &base, &priv, num_batches, max, num_isogenies, my);
+}
+static void run_action_with(void) {
+	action_with(&out, &base, &priv, num_batches, max, num_isogenies, my, &scratch);
+}
+static void run_csidh(void) {
+	csidh(&out, &pub, &priv, num_batches, max, num_isogenies, my);
+}
+static void run_csidh_with(void) {
+	csidh_with(&out, &pub, &priv, num_batches, max, num_isogenies, my, &scratch);
+}
+
+static void run_ctidh_private(void) { ctidh_private(&ctidh_priv); }
+static void run_ctidh_action(void) { ctidh_action(&out, &base, &ctidh_priv); }
+static void run_ctidh(void) { ctidh(&out, &pub, &ctidh_priv); }
+static void run_ctidh_action_with(void) { ctidh_action_with(&out, &base, &ctidh_priv, &ctidh_scratch_); }
+static void run_ctidh_with(void) { ctidh_with(&out, &pub, &ctidh_priv, &ctidh_scratch_); }
+
+static void *thread(void *run) {
+	((void (*)(void)) run)();
+	return NULL;
+}
+
+static size_t measure(void (*run)(void)) {
+	static uint8_t *stack;
+	pthread_attr_t attr;
+	pthread_t t;
+	size_t i;
+
+	if (!stack && !(stack = aligned_alloc(4096, stack_size)))
+		exit(1);
+	memset(stack, paint, stack_size);
+
+	pthread_attr_init(&attr);
+	pthread_attr_setstack(&attr, stack, stack_size);
+	if (pthread_create(&t, &attr, thread, (void *) run)) {
+		perror("pthread_create");
+		exit(1);
+	}
+	pthread_join(t, NULL);
+	pthread_attr_destroy(&attr);
+
+	/* the stack grows downwards */
+	for (i = 0; i < stack_size && stack[i] == paint; ++i);
+	return stack_size - i;
+}
+
+int main() {
+	struct {
+		char const *name;
+		void (*run)(void);
+		size_t limit;
+	} const entries[] = {
+		{ "csidh_private", run_csidh_private, csidh_stack_max },
+		{ "xMUL", run_xMUL, csidh_stack_max },
+		{ "elligator", run_elligator, csidh_stack_max },
+		{ "xISOG", run_xISOG, csidh_stack_max },
+		{ "lastxISOG", run_lastxISOG, csidh_stack_max },
+		{ "validate", run_validate, csidh_stack_max },
+		{ "validate_batch", run_validate_batch, csidh_stack_max },
+		{ "validate_with", run_validate_with, csidh_stack_with_max },
+		{ "validate_batch_with", run_validate_batch_with, csidh_stack_with_max },
+		{ "action", run_action, csidh_stack_max },
+		{ "action_with", run_action_with, csidh_stack_with_max },
+		{ "csidh", run_csidh, csidh_stack_max },
+		{ "csidh_with", run_csidh_with, csidh_stack_with_max },
+		{ "ctidh_private", run_ctidh_private, csidh_stack_max },
+		{ "ctidh_action", run_ctidh_action, csidh_stack_max },
+		{ "ctidh", run_ctidh, csidh_stack_max },
+		{ "ctidh_action_with", run_ctidh_action_with, csidh_stack_with_max },
+		{ "ctidh_with", run_ctidh_with, csidh_stack_with_max },
+	};
+
+	for (int i = 2; i <= 10; i++) {
+		fp_set(&invs_[i - 2], i);
+		fp_sq1(&invs_[i - 2]);
+		fp_sub2(&invs_[i - 2], &fp_1);
+		fp_inv(&invs_[i - 2]);
+	}
+
+	csidh_private(&priv, max);
+	ctidh_private(&ctidh_priv);
+	action(&pub, &base, &priv, num_batches, max, num_isogenies, my);
+	curve_set(&E, &(proj) { pub.A, fp_1 });
+	elligator(&P, &Pd, &E.A);
+	K = P;
+
+	size_t base_usage = measure(run_nothing);
+
+	int failed = 0;
+	printf("%-20s %8s %8s\n", "stack bytes", "peak", "limit");
+	for (size_t i = 0; i < sizeof(entries) / sizeof(*entries); ++i) {
+		size_t peak = measure(entries[i].run) - base_usage;
+		bool over = peak > entries[i].limit;
+		printf("%-20s %8zu %8zu%s\n", entries[i].name, peak, entries[i].limit, over ? "  over the limit" : "");
+		failed |= over;
+	}
+	printf("\nsizeof(csidh_scratch) = %zu bytes\n", sizeof(csidh_scratch));
+	printf("sizeof(ctidh_scratch) = %zu bytes\n", sizeof(ctidh_scratch));
+	return failed;
+}
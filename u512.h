@@ -4,8 +4,11 @@
 #include <stdbool.h>
 #include <stdint.h>
 
+#include "params.h"
+
+/* the name is historic: LIMBS 64-bit words, see params.h */
 typedef struct u512 {
-    uint64_t c[8];
+    uint64_t c[LIMBS];
 } u512;
 
 extern const u512 u512_1;
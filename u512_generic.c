@@ -0,0 +1,52 @@
+
+#include <stddef.h>
+
+#include "u512.h"
+
+/* portable C version of u512.S for any LIMBS */
+
+const u512 u512_1 = { .c = { 1 } };
+
+void u512_set(u512 *x, uint64_t y)
+{
+    x->c[0] = y;
+    for (size_t i = 1; i < LIMBS; ++i)
+        x->c[i] = 0;
+}
+
+bool u512_bit(u512 const *x, uint64_t k)
+{
+    return x->c[k / 64] >> (k % 64) & 1;
+}
+
+bool u512_add3(u512 *x, u512 const *y, u512 const *z)
+{
+    unsigned char c = 0;
+    for (size_t i = 0; i < LIMBS; ++i) {
+        unsigned __int128 t = (unsigned __int128) y->c[i] + z->c[i] + c;
+        x->c[i] = t;
+        c = t >> 64;
+    }
+    return c;
+}
+
+bool u512_sub3(u512 *x, u512 const *y, u512 const *z)
+{
+    unsigned char b = 0;
+    for (size_t i = 0; i < LIMBS; ++i) {
+        unsigned __int128 t = (unsigned __int128) y->c[i] - z->c[i] - b;
+        x->c[i] = t;
+        b = t >> 64 & 1;
+    }
+    return b;
+}
+
+void u512_mul3_64(u512 *x, u512 const *y, uint64_t z)
+{
+    uint64_t c = 0;
+    for (size_t i = 0; i < LIMBS; ++i) {
+        unsigned __int128 t = (unsigned __int128) y->c[i] * z + c;
+        x->c[i] = t;
+        c = t >> 64;
+    }
+}
@@ -0,0 +1,103 @@
+
+#include <errno.h>
+#include <sys/socket.h>
+
+#include "wire.h"
+
+static void put64(uint8_t *buf, uint64_t x)
+{
+    for (size_t i = 0; i < 8; ++i)
+        buf[i] = x >> 8 * i;
+}
+
+static uint64_t get64(uint8_t const *buf)
+{
+    uint64_t x = 0;
+    for (size_t i = 0; i < 8; ++i)
+        x |= (uint64_t) buf[i] << 8 * i;
+    return x;
+}
+
+void wire_put_header(uint8_t *buf, uint8_t type, uint8_t status, uint16_t len)
+{
+    buf[0] = type;
+    buf[1] = status;
+    buf[2] = len;
+    buf[3] = len >> 8;
+}
+
+void wire_get_header(uint8_t const *buf, uint8_t *type, uint8_t *status, uint16_t *len)
+{
+    *type = buf[0];
+    *status = buf[1];
+    *len = buf[2] | buf[3] << 8;
+}
+
+void wire_put_key(uint8_t *buf, public_key const *key)
+{
+    u512 a;
+    fp_dec(&a, &key->A);
+    for (size_t i = 0; i < LIMBS; ++i)
+        put64(buf + 8 * i, a.c[i]);
+}
+
+bool wire_get_key(public_key *key, uint8_t const *buf)
+{
+    u512 a, t;
+    for (size_t i = 0; i < LIMBS; ++i)
+        a.c[i] = get64(buf + 8 * i);
+    if (!u512_sub3(&t, &a, &fp_p))
+        return false;
+    fp_enc(&key->A, &a);
+    return true;
+}
+
+void wire_put_stats(uint8_t *buf, wire_stats const *s)
+{
+    put64(buf +  0, s->exchanges);
+    put64(buf +  8, s->invalid);
+    put64(buf + 16, s->cpu_ns);
+    put64(buf + 24, s->pool_taken);
+    put64(buf + 32, s->pool_misses);
+    put64(buf + 40, s->connections);
+}
+
+void wire_get_stats(wire_stats *s, uint8_t const *buf)
+{
+    s->exchanges = get64(buf +  0);
+    s->invalid = get64(buf +  8);
+    s->cpu_ns = get64(buf + 16);
+    s->pool_taken = get64(buf + 24);
+    s->pool_misses = get64(buf + 32);
+    s->connections = get64(buf + 40);
+}
+
+bool wire_send(int fd, void const *buf, size_t len)
+{
+    uint8_t const *p = buf;
+    while (len) {
+        ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        len -= n;
+    }
+    return true;
+}
+
+bool wire_recv(int fd, void *buf, size_t len)
+{
+    uint8_t *p = buf;
+    while (len) {
+        ssize_t n = recv(fd, p, len, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        len -= n;
+    }
+    return true;
+}
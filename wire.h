@@ -0,0 +1,52 @@
+#ifndef WIRE_H
+#define WIRE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "csidh.h"
+
+/* framing between csidhd, the key-exchange daemon, and loadgen. */
+/* every message is a 4-byte header followed by len bytes of payload: */
+/* type, status, len as 16-bit little-endian. requests carry status 0, */
+/* the response echoes the type of its request. */
+
+enum wire_type {
+    WIRE_EXCHANGE = 1,  /* client public key -> server public key */
+    WIRE_STATS = 2,     /* no payload -> wire_stats */
+};
+
+enum wire_status {
+    WIRE_OK = 0,
+    WIRE_INVALID_KEY = 1,   /* not a supersingular curve; no payload */
+    WIRE_BAD_REQUEST = 2,   /* unknown type or length; the daemon hangs up */
+};
+
+typedef struct wire_stats {
+    uint64_t exchanges;     /* answered exchange requests, including invalid keys */
+    uint64_t invalid;
+    uint64_t cpu_ns;        /* user and system time of the daemon, all threads */
+    uint64_t pool_taken;
+    uint64_t pool_misses;   /* ephemeral keys generated inline */
+    uint64_t connections;
+} wire_stats;
+
+#define wire_header_len 4
+#define wire_key_len (8 * LIMBS)   /* the coefficient A as a little-endian integer */
+#define wire_stats_len (8 * 6)
+#define wire_max_len (wire_key_len > wire_stats_len ? wire_key_len : wire_stats_len)
+
+void wire_put_header(uint8_t *buf, uint8_t type, uint8_t status, uint16_t len);
+void wire_get_header(uint8_t const *buf, uint8_t *type, uint8_t *status, uint16_t *len);
+
+void wire_put_key(uint8_t *buf, public_key const *key);
+bool wire_get_key(public_key *key, uint8_t const *buf); /* false unless A < p */
+
+void wire_put_stats(uint8_t *buf, wire_stats const *s);
+void wire_get_stats(wire_stats *s, uint8_t const *buf);
+
+/* blocking, the whole buffer or false */
+bool wire_send(int fd, void const *buf, size_t len);
+bool wire_recv(int fd, void *buf, size_t len);
+
+#endif